@@ -0,0 +1,153 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Time stepped physics simulation of the X-Ray Bougie Bot for the host build
+* ------------------------------------------------------------------------
+*/
+
+#ifndef ROBOT_SIM_H
+#define ROBOT_SIM_H
+
+#include "vex-host.h"
+
+namespace vexhost {
+    /*
+    * Physical constants of the robot and the field. The defaults are estimates of the X-Ray Bougie Bot; ports follow include/robot-config.h
+    * (PORTn is index n - 1).
+    * Angles of the arm and ramp are motor output shaft degrees relative to where they start, like the robot code measures them.
+    */
+    struct SimulationParameters {
+        // ports
+        int baseTopLeftPort = 8;
+        int baseBottomLeftPort = 11;
+        int baseTopRightPort = 7;
+        int baseBottomRightPort = 0;
+        int leftIntakePort = 1;
+        int rightIntakePort = 14;
+        int rampLiftPort = 9;
+        int armPivotPort = 6;
+        int rightSonarPort = 2; // three wire port C
+        int leftSonarPort = 4; // three wire port E
+        int backSonarPort = 0; // three wire port A
+
+        // V5 smart motor: 36:1 cartridge values, the other cartridges trade torque for speed in proportion
+        double stallTorque36 = 2.1; // Nm at the output shaft
+        double stallCurrent = 2.5; // amps, also the current limit
+        double maxVoltage = 12; // volts the motor regulates to
+        double velocityGain = 4; // internal velocity loop, volts per volt of speed error
+        double holdGain = 0.6; // internal hold loop, volts per degree
+        double holdDamping = 0.02; // volts per degree / second
+        double thermalCapacity = 40; // joules / kelvin
+        double thermalResistance = 4; // kelvin / watt to the air
+        double windingResistance = 4.8; // ohms
+        double ambientTemperature = 25; // celsius
+        double batteryVoltage = 12.8; // volts; the motors get up to 0.8 V less, so below 12.8 they can no longer reach maxVoltage
+
+        // drive: 1100 motor degrees per wheel rotation, 0.319 m wheel circumference
+        double wheelCircumference = 0.319185814; // meters
+        double motorDegreesPerWheelRotation = 1100;
+        double trackWidth = 0.2553; // meters, effective, matches the turn calibration of the robot code
+        double mass = 6.0; // kg
+        double yawInertia = 0.20; // kg m^2
+        double sideWheelMass = 0.8; // kg, rotor, gearing and wheel inertia of one side reflected to the wheel surface
+        double wheelFriction = 0.9; // traction coefficient
+        double slipVelocity = 0.05; // m/s of wheel slip at which traction is 76% developed
+        double rollingResistance = 0.03; // fraction of the weight
+        double scrubTorque = 0.6; // Nm resisting turns in place (four wheel skid steer)
+
+        // arm pivot (36:1) and ramp lift (36:1), external reduction to the joint
+        double armRatio = 7; // motor degrees per arm degree
+        double armInertia = 0.010; // kg m^2 at the motor output shaft
+        double armGravityTorque = 0.6; // Nm at the motor output shaft with the arm horizontal
+        double armStartAngle = -30; // arm degrees from horizontal at motor angle 0
+        double armMinimum = 0; // hard stops, motor degrees; the arm and the ramp start resting on theirs
+        double armMaximum = 640;
+        double rampRatio = 9.8;
+        double rampInertia = 0.015;
+        double rampGravityTorque = 0.5;
+        double rampStartAngle = 30; // ramp degrees from horizontal when retracted
+        double rampMinimum = -620;
+        double rampMaximum = 0;
+        double jointFriction = 0.02; // Nm / (rad / s) at the motor output shaft
+
+        // intake rollers (6:1)
+        double intakeInertia = 0.0005; // kg m^2 at the motor output shaft
+        double intakeFriction = 0.002; // Nm / (rad / s)
+
+        // where the robot actually starts relative to the starting pose the routine assumes (meters, meters, degrees), for placement errors
+        double startX = 0;
+        double startY = 0;
+        double startHeading = 0;
+
+        // field: 3.66 m square, the starting pose of the robot on it and the sonar mounts (robot frame, meters)
+        double fieldSize = 3.66;
+        double startFieldX = 0.6; // meters from the wall behind the robot
+        double startFieldY = 0.9; // meters from the wall on the left of the robot
+        double startFieldHeading = 0; // degrees clockwise
+        double sonarOffset = 0.2; // distance of each sonar from the center of the robot
+        double sonarMaxRange = 2.5; // meters, farther walls give no echo
+        double sonarNoise = 0.005; // meters, standard deviation
+
+        unsigned int seed = 1; // noise seed
+        int substeps = 4; // integration steps per world step
+    };
+
+    /*
+    * Pose and speed of the chassis in the frame of the starting pose the routine assumes (same frame as the robot code's Pose: x forward, y right,
+    * heading clockwise)
+    */
+    struct ChassisState {
+        double x;
+        double y;
+        double heading; // degrees
+        double velocity; // m/s forwards
+        double angularVelocity; // degrees / second clockwise
+    };
+
+    /*
+    * RobotSimulation class. Physics model of the robot for World::setPhysics.
+    *   - every port is a DC motor with its gear cartridge: torque falls linearly from stall torque to zero at free speed, the current is limited,
+    *     the winding heats up with I^2 R. The motor's own velocity and hold loops are modeled as simple proportional loops on the voltage
+    *   - each side of the drive pushes on the chassis through its wheels; traction saturates at wheelFriction times the side's weight, so the
+    *     wheels slip under hard acceleration. The chassis has mass, yaw inertia, rolling resistance and scrub torque
+    *   - the arm and the ramp are joints with inertia, gravity and hard stops; the intake rollers and any other installed motor have inertia
+    *     and friction
+    *   - the sonars measure the distance to the field walls with noise
+    * Integration is semi-implicit Euler in substeps of each world step.
+    */
+    class RobotSimulation : public Physics {
+        private:
+            SimulationParameters parameters;
+            ChassisState chassis;
+            double leftWheelVelocity = 0; // m/s of wheel surface
+            double rightWheelVelocity = 0;
+            double shaftVelocity[motorPorts]; // rad/s of the motor output shafts that are not on the drive
+            unsigned int noiseState;
+
+            double motorTorque(MotorState &motor, double omega, double dt);
+            void stepDrive(World &world, double dt);
+            void stepShaft(World &world, int port, double inertia, double gravity, double friction, double minimum, double maximum, double dt);
+            void updateSonars(World &world);
+            double castRay(double x, double y, double heading) const;
+            double gaussian();
+
+        public:
+            RobotSimulation(const SimulationParameters &myParameters = SimulationParameters());
+
+            void step(World &world, double dt);
+
+            const ChassisState &getChassis() const {
+                return chassis;
+            };
+            const SimulationParameters &getParameters() const {
+                return parameters;
+            };
+            // arm and ramp joint angle from horizontal (degrees)
+            double armAngle(const World &world) const;
+            double rampAngle(const World &world) const;
+    };
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Runs one autonomous routine of the robot program from rest in a world of its own, for the benchmark, the sweep and the gain tuner,
+*       and the driver loop on scripted controller inputs for the latency benchmark
+* ------------------------------------------------------------------------
+*/
+
+#ifndef ROUTINE_RUNNER_H
+#define ROUTINE_RUNNER_H
+
+#include "robot-sim.h"
+#include "odometry.h"
+#include "routine-profiler.h"
+#include "control-scheduler.h"
+#include "latency-meter.h"
+#include "robot-gains.h"
+
+#include <vector>
+
+namespace vexhost {
+    static const int firstRoutine = 1;
+    static const int lastRoutine = 6;
+    static const int skillsRoutine = 5;
+    // check routine of the bench, not a match routine: drives an S of two quarter circles and a half circle back with radius turns,
+    // so the end pose can be compared with the target pose
+    static const int radiusTurnRoutine = 9;
+
+    /*
+    * One run of a routine
+    *   - finished: the routine returned before the time limit
+    *   - seconds: time the routine took, or the time limit
+    *   - sleepSeconds / settleSeconds / idleSeconds: time spent in sleepFor, settling at the end of motions, and with the base standing still
+    *   - pose / target: where the robot ended up (simulation ground truth, odometry with ideal physics) and the target pose of the routine
+    *   - odometry: pose the robot believes it is at
+    *   - records: every primitive of the routine (see RoutineProfiler)
+    *   - loop: timing statistics of the routine's control loop (see ControlScheduler). Computation takes no virtual time on the host, so
+    *     only overruns and jitter caused by blocking in the loop show up here
+    */
+    struct RoutineResult {
+        int routine;
+        bool finished;
+        double seconds;
+        double sleepSeconds;
+        double settleSeconds;
+        double idleSeconds;
+        Pose pose;
+        Pose target;
+        Pose odometry;
+        std::vector<RoutineProfiler::Record> records;
+        ControlScheduler::Statistics loop;
+    };
+
+    /*
+    * One run of the driver loop
+    *   - seconds: how long driverMain ran
+    *   - channelNames / latency: the subsystems of the robot's latency meter and their latency statistics (see LatencyMeter)
+    *   - samples: every input change that got its motor command, droppedSamples: those that did not fit into the meter's sample list
+    *   - handlerCalls / handlerSkips: subsystem input handlers the driver loop called, and skipped because none of their inputs changed
+    *   - loop: timing statistics of the driver loop
+    */
+    struct DriverResult {
+        double seconds;
+        const char *channelNames[LatencyMeter::maxChannels];
+        LatencyMeter::Statistics latency[LatencyMeter::maxChannels];
+        std::vector<LatencyMeter::Sample> samples;
+        uint32_t droppedSamples;
+        uint32_t handlerCalls;
+        uint32_t handlerSkips;
+        ControlScheduler::Statistics loop;
+    };
+
+    /*
+    * Spread of the randomized conditions of the sweep and the gain tuner. Each run draws its own values around the defaults of SimulationParameters
+    *   - battery: uniform between minimum and maximum voltage
+    *   - traction: normal around wheelFriction, limited to [0.5, 1.2]; slip velocity uniform
+    *   - mass: normal around the robot's mass (cubes carried, battery and parts swapped)
+    *   - placement: normal error of the robot's position (meters) and heading (degrees) on the starting tile
+    *   - sonar noise: uniform standard deviation, each run with its own noise seed
+    */
+    struct Variation {
+        double batteryMinimum = 11.8;
+        double batteryMaximum = 12.9;
+        double tractionSpread = 0.1;
+        double slipMinimum = 0.03;
+        double slipMaximum = 0.08;
+        double massSpread = 0.3;
+        double placementSpread = 0.01;
+        double headingSpread = 1;
+        double sonarNoiseMinimum = 0.002;
+        double sonarNoiseMaximum = 0.02;
+    };
+
+    /* ------------------------------------------------------------------------
+    * Function: runRoutine
+    * Desc: runs autonomousMain(routine), or the check routine radiusTurnRoutine, from rest with a fresh World and Robot on the calling thread.
+    *       Runs on different threads are independent, so several can run in parallel
+    * Param: routine number, time limit (seconds), simulation parameters, true to run with ideal physics instead of the simulation,
+    *        gains to run the robot with (0 for those of tuned-gains.h), file to write the Chrome trace of the run to (0 for none)
+    * Output: returns the result of the run
+    */
+    RoutineResult runRoutine(int routine, double limitSeconds, const SimulationParameters &parameters, bool ideal, const RobotGains *gains = 0,
+                             const char *traceFile = 0);
+
+    /* ------------------------------------------------------------------------
+    * Function: runDriver
+    * Desc: runs driverMain with latency measurement from rest with a fresh World and Robot on the calling thread, feeding it the scripted
+    *       controller inputs, and stops it after the given time. Runs on different threads are independent
+    * Param: length of the run (seconds), controller events in time order (times relative to the start of driverMain), simulation
+    *        parameters, true to run with ideal physics instead of the simulation
+    * Output: returns the result of the run
+    */
+    DriverResult runDriver(double seconds, const std::vector<ControllerEvent> &script, const SimulationParameters &parameters, bool ideal);
+
+    /* ------------------------------------------------------------------------
+    * Function: randomize
+    * Desc: draws the conditions of one run. The generator is seeded from the seed, routine and run number, so the conditions do not depend
+    *       on the order or the thread the runs are made on
+    * Param: seed, routine, run number, spread of the conditions
+    * Output: returns the simulation parameters of the run
+    */
+    SimulationParameters randomize(unsigned int seed, int routine, int run, const Variation &variation);
+
+    // length of the period a routine is written for: the 15 second autonomous period, or the minute of programming skills
+    double routineWindow(int routine);
+    // distance between the positions of two poses (meters)
+    double positionError(const Pose &a, const Pose &b);
+}
+
+#endif
@@ -0,0 +1,20 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Host stand-in for the V5 SDK's v5.h. The robot program only uses the vex:: C++ API (v5_vcs.h), so this only pulls in the
+*       standard headers the SDK header provides
+* ------------------------------------------------------------------------
+*/
+
+#ifndef V5_H
+#define V5_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define V5_MAX_DEVICE_PORTS 32
+
+#endif
@@ -0,0 +1,299 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Host stand-in for the subset of the vex:: C++ API (v5_vcs.h) used by the robot program, so src/main.cpp builds and runs on Linux
+* ------------------------------------------------------------------------
+*/
+
+#ifndef V5_VCS_H
+#define V5_VCS_H
+
+#include "v5.h"
+
+/*
+* Every device object is only a handle (port or three wire port index). The state behind it lives in the vexhost::World of the calling
+* thread (see vex-host.h): the virtual clock, the motor model, scripted controller inputs and the tasks of one simulated robot.
+* Names, signatures and units follow the VEXcode V5 Text SDK.
+*/
+namespace vex {
+    const int32_t PORT1 = 0;
+    const int32_t PORT2 = 1;
+    const int32_t PORT3 = 2;
+    const int32_t PORT4 = 3;
+    const int32_t PORT5 = 4;
+    const int32_t PORT6 = 5;
+    const int32_t PORT7 = 6;
+    const int32_t PORT8 = 7;
+    const int32_t PORT9 = 8;
+    const int32_t PORT10 = 9;
+    const int32_t PORT11 = 10;
+    const int32_t PORT12 = 11;
+    const int32_t PORT13 = 12;
+    const int32_t PORT14 = 13;
+    const int32_t PORT15 = 14;
+    const int32_t PORT16 = 15;
+    const int32_t PORT17 = 16;
+    const int32_t PORT18 = 17;
+    const int32_t PORT19 = 18;
+    const int32_t PORT20 = 19;
+    const int32_t PORT21 = 20;
+
+    enum class gearSetting { ratio36_1, ratio18_1, ratio6_1 };
+    enum class directionType { fwd, rev, undefined };
+    enum class brakeType { coast, brake, hold, undefined };
+    enum class rotationUnits { deg, rev, raw };
+    enum class velocityUnits { pct, rpm, dps };
+    enum class percentUnits { pct };
+    enum class voltageUnits { volt, mV };
+    enum class currentUnits { amp };
+    enum class temperatureUnits { celsius, fahrenheit };
+    enum class torqueUnits { Nm, InLb };
+    enum class distanceUnits { mm, in, cm };
+    enum class timeUnits { sec, msec };
+    enum class controllerType { primary, partner };
+
+    /*
+    * timer: virtual clock of the calling thread's world
+    */
+    class timer {
+        private:
+            uint64_t startMicros;
+
+        public:
+            timer();
+            double time(timeUnits units = timeUnits::msec) const;
+            void clear();
+
+            static uint32_t system();
+            static uint64_t systemHighResolution();
+    };
+
+    /*
+    * motor: smart motor on a port. Positions and velocities are of the output shaft, after the gear cartridge
+    */
+    class motor {
+        private:
+            int32_t port;
+
+        public:
+            motor(int32_t index);
+            motor(int32_t index, bool reverse);
+            motor(int32_t index, gearSetting gears, bool reverse = false);
+
+            void spin(directionType dir);
+            void spin(directionType dir, double velocity, velocityUnits units);
+            void spin(directionType dir, double velocity, percentUnits units);
+            void spin(directionType dir, double voltage, voltageUnits units);
+            void stop();
+            void stop(brakeType mode);
+
+            void setVelocity(double velocity, velocityUnits units);
+            void setVelocity(double velocity, percentUnits units);
+            void setStopping(brakeType mode);
+            void setMaxTorque(double value, percentUnits units);
+            void setMaxTorque(double value, currentUnits units);
+            void setReversed(bool value);
+            void resetRotation();
+            void resetPosition();
+            void setRotation(double value, rotationUnits units);
+            void setPosition(double value, rotationUnits units);
+
+            double rotation(rotationUnits units);
+            double position(rotationUnits units);
+            double velocity(velocityUnits units);
+            double velocity(percentUnits units);
+            double current(currentUnits units = currentUnits::amp);
+            double current(percentUnits units);
+            double voltage(voltageUnits units = voltageUnits::volt);
+            double torque(torqueUnits units = torqueUnits::Nm);
+            double temperature(temperatureUnits units = temperatureUnits::celsius);
+            double temperature(percentUnits units);
+            bool isSpinning();
+            bool installed();
+            int32_t index();
+    };
+
+    /*
+    * triport: the brain's eight three wire ports
+    */
+    class triport {
+        public:
+            class port {
+                private:
+                    int32_t portIndex;
+
+                public:
+                    port(int32_t index);
+                    int32_t index() const;
+            };
+
+            port A;
+            port B;
+            port C;
+            port D;
+            port E;
+            port F;
+            port G;
+            port H;
+
+            triport();
+    };
+
+    /*
+    * sonar: ultrasonic range finder on a pair of three wire ports (output on the given port)
+    */
+    class sonar {
+        private:
+            int32_t portIndex;
+
+        public:
+            sonar(triport::port &port);
+            double distance(distanceUnits units);
+            bool foundObject();
+    };
+
+    /*
+    * brain: screen, three wire ports and SD card of the robot brain
+    */
+    class brain {
+        public:
+            class lcd {
+                public:
+                    void print(const char *format, ...);
+                    void print(int32_t value);
+                    void print(double value);
+                    void printAt(int32_t x, int32_t y, const char *format, ...);
+                    void newLine();
+                    void clearScreen();
+                    void clearLine();
+                    void clearLine(int32_t number);
+                    void setCursor(int32_t row, int32_t col);
+                    int32_t row();
+                    int32_t column();
+                    void drawRectangle(int32_t x, int32_t y, int32_t width, int32_t height, const char *color = 0);
+                    void drawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+                    bool render();
+                    int32_t xPosition();
+                    int32_t yPosition();
+                    bool pressing();
+            };
+
+            class sdcard {
+                public:
+                    bool isInserted();
+                    int32_t loadfile(const char *name, uint8_t *buffer, int32_t len);
+                    int32_t savefile(const char *name, uint8_t *buffer, int32_t len);
+                    int32_t appendfile(const char *name, uint8_t *buffer, int32_t len);
+                    int32_t size(const char *name);
+                    bool exists(const char *name);
+            };
+
+            lcd Screen;
+            triport ThreeWirePort;
+            sdcard SDcard;
+            timer Timer;
+    };
+
+    /*
+    * controller: V5 controller. Inputs come from the world's scripted controller state
+    */
+    class controller {
+        public:
+            class axis {
+                private:
+                    int32_t axisIndex;
+
+                public:
+                    axis(int32_t index);
+                    int32_t value() const;
+                    int32_t position(percentUnits units) const;
+            };
+
+            class button {
+                private:
+                    int32_t buttonIndex;
+
+                public:
+                    button(int32_t index);
+                    bool pressing() const;
+            };
+
+            axis Axis1;
+            axis Axis2;
+            axis Axis3;
+            axis Axis4;
+
+            button ButtonL1;
+            button ButtonL2;
+            button ButtonR1;
+            button ButtonR2;
+            button ButtonUp;
+            button ButtonDown;
+            button ButtonLeft;
+            button ButtonRight;
+            button ButtonX;
+            button ButtonB;
+            button ButtonY;
+            button ButtonA;
+
+            controller(controllerType type = controllerType::primary);
+    };
+
+    /*
+    * competition: registers the autonomous and driver control callbacks. The host harness plays field control and runs them in their own tasks
+    */
+    class competition {
+        public:
+            competition();
+            void autonomous(void (*callback)(void));
+            void drivercontrol(void (*callback)(void));
+            bool isAutonomous();
+            bool isDriverControl();
+            bool isEnabled();
+            bool isCompetitionSwitch();
+            bool isFieldControl();
+    };
+
+    /*
+    * task: cooperative task. Tasks of a world take turns on the virtual clock: a task runs until it sleeps or yields, then the task with the
+    * earliest wake up time (highest priority first on ties) runs next
+    */
+    class task {
+        private:
+            int32_t taskId;
+
+        public:
+            static const int32_t taskPrioritylow = 1;
+            static const int32_t taskPriorityNormal = 7;
+            static const int32_t taskPriorityHigh = 15;
+
+            task();
+            task(int (*callback)(void));
+            task(int (*callback)(void), int32_t priority);
+            task(int (*callback)(void *), void *arg);
+            task(int (*callback)(void *), void *arg, int32_t priority);
+
+            void stop();
+            void suspend();
+            void resume();
+            int32_t priority();
+            void setPriority(int32_t priority);
+            int32_t index();
+
+            static void sleep(uint32_t time);
+            static void yield();
+    };
+
+    namespace this_thread {
+        void sleep_for(uint32_t time);
+        void yield();
+        // id and priority of the calling task
+        int32_t get_id();
+        int32_t priority();
+        void setPriority(int32_t priority);
+    }
+}
+
+#endif
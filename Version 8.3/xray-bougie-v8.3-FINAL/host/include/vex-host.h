@@ -0,0 +1,267 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Host side of the vex:: stand-in: the simulated world behind the device handles, its virtual clock and its tasks
+* ------------------------------------------------------------------------
+*/
+
+#ifndef VEX_HOST_H
+#define VEX_HOST_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace vexhost {
+    static const int motorPorts = 21;
+    static const int triportPorts = 8;
+
+    enum Button {
+        BUTTON_L1, BUTTON_L2, BUTTON_R1, BUTTON_R2, BUTTON_UP, BUTTON_DOWN, BUTTON_LEFT, BUTTON_RIGHT, BUTTON_X, BUTTON_B, BUTTON_Y, BUTTON_A,
+        BUTTON_COUNT
+    };
+
+    enum MotorMode { MOTOR_STOPPED, MOTOR_VELOCITY, MOTOR_VOLTAGE };
+    enum StopMode { STOP_COAST, STOP_BRAKE, STOP_HOLD };
+
+    /*
+    * State of one smart motor. The command fields are written by vex::motor, the measured fields by the physics model.
+    * Angles and speeds are of the output shaft after the gear cartridge, in the motor's own direction (before setReversed)
+    */
+    struct MotorState {
+        bool installed;
+        bool reversed;
+        double maxRpm; // free speed of the gear cartridge: 100, 200 or 600
+        MotorMode mode;
+        double command; // MOTOR_VELOCITY: rpm, MOTOR_VOLTAGE: volts
+        StopMode stopping; // brake mode used by stop() without arguments and while stopped
+        double defaultVelocity; // rpm used by spin(direction)
+        double maxTorquePercent;
+        double holdPosition; // degrees, position a hold stop keeps
+
+        double position; // degrees
+        double positionOffset; // degrees subtracted by rotation(), set by resetRotation / setRotation
+        double velocity; // rpm
+        double current; // amps
+        double voltage; // volts
+        double torque; // Nm
+        double temperature; // celsius
+    };
+
+    /*
+    * State of the primary controller. Axes in percent [-100, 100]
+    */
+    struct ControllerState {
+        double axis[4]; // Axis1 .. Axis4
+        bool buttons[BUTTON_COUNT];
+    };
+
+    /*
+    * Controller state that becomes active at a point in time, for scripted driver inputs
+    */
+    struct ControllerEvent {
+        uint64_t micros;
+        ControllerState state;
+    };
+
+    class World;
+
+    /*
+    * Physics class. Advances the measured state of the devices by one time step. The default model is ideal: every motor runs exactly
+    * at its commanded speed. A simulator replaces it with World::setPhysics
+    */
+    class Physics {
+        public:
+            virtual ~Physics() {};
+            virtual void step(World &world, double dt) = 0;
+    };
+
+    class IdealPhysics : public Physics {
+        public:
+            void step(World &world, double dt);
+    };
+
+    /*
+    * Thrown out of vex::task::sleep in every task once the world shuts down, so tasks that never return (e.g. the driver loop) unwind
+    */
+    struct SessionEnd {};
+
+    enum CompetitionMode { MODE_DISABLED, MODE_AUTONOMOUS, MODE_DRIVER };
+
+    /*
+    * World class. Everything behind the vex:: handles of one simulated robot: devices, virtual clock, competition state and tasks.
+    * Each thread works on its current world (setCurrentWorld), and tasks started in a world belong to it, so several worlds can run
+    * side by side on different threads.
+    * Tasks are real threads, but only the task holding the world's turn runs; sleeping hands the turn to the task that wakes up first and
+    * advances the virtual clock to its wake up time, stepping the physics in steps of at most stepMicros. Runs are deterministic.
+    */
+    class World {
+        public:
+            typedef int (*TaskFunction)(void *);
+
+        private:
+            struct Task {
+                int32_t id;
+                int32_t priority;
+                uint64_t wakeMicros;
+                uint64_t readySequence; // order the task became ready in, so tasks with the same wake up time and priority take turns
+                bool finished;
+                bool suspended;
+                TaskFunction function;
+                void *argument;
+                std::thread thread;
+                std::thread::id owner; // thread running the task
+            };
+
+            uint64_t micros = 0;
+            uint64_t stepMicros = 1000;
+            uint64_t deadlineMicros = 0; // 0 for no deadline
+
+            Physics *physics;
+            IdealPhysics idealPhysics;
+
+            std::vector<ControllerEvent> controllerScript;
+            size_t nextControllerEvent = 0;
+
+            std::string screenLine;
+            int32_t screenRow = 1;
+            bool echoScreen = false;
+            uint64_t screenLines = 0;
+
+            std::string sdCardDirectory;
+
+            void (*autonomousCallback)(void) = 0;
+            void (*driverCallback)(void) = 0;
+            CompetitionMode competitionMode = MODE_DISABLED;
+
+            std::mutex mutex;
+            std::condition_variable turnChanged;
+            std::vector<Task *> tasks;
+            Task *running = 0;
+            uint64_t readyCounter = 0;
+            bool shuttingDown = false;
+
+            Task *attachThread();
+            Task *pickNext();
+            void advanceTo(uint64_t target);
+            void handOff(Task *self, std::unique_lock<std::mutex> &lock);
+            static void taskMain(World *world, Task *task);
+
+        public:
+            MotorState motors[motorPorts];
+            double sonarMillimeters[triportPorts];
+            ControllerState controller;
+
+            World();
+            ~World();
+
+            // copy the configuration of the installed motors (cartridge, stop mode, torque limit, direction) from another world, e.g. the default
+            // world the global vex:: device handles were constructed in. Positions and measurements start from rest
+            void installDevices(const World &other);
+
+            /*
+            * Clock
+            */
+            uint64_t currentMicros() const {
+                return micros;
+            };
+            void setStepMicros(uint64_t myStepMicros) {
+                stepMicros = myStepMicros;
+            };
+            // the world shuts down once the virtual clock reaches the deadline (microseconds, 0 for none)
+            void setDeadline(uint64_t myDeadlineMicros) {
+                deadlineMicros = myDeadlineMicros;
+            };
+            void setPhysics(Physics *myPhysics) {
+                physics = myPhysics ? myPhysics : &idealPhysics;
+            };
+
+            /*
+            * Tasks. sleep and yield must be called from a task of this world (the thread that created the world counts as one)
+            */
+            int32_t startTask(TaskFunction function, void *argument, int32_t priority);
+            void stopTask(int32_t id);
+            void suspendTask(int32_t id, bool suspend);
+            void setTaskPriority(int32_t id, int32_t priority);
+            int32_t taskPriority(int32_t id);
+            // id of the calling task (a thread that is not a task of this world becomes one)
+            int32_t currentTask();
+            void sleep(uint32_t millis);
+            // stop every task and wait for their threads. Called by the destructor
+            void shutdown();
+            bool isShuttingDown();
+
+            /*
+            * Competition
+            */
+            void setAutonomousCallback(void (*callback)(void)) {
+                autonomousCallback = callback;
+            };
+            void setDriverCallback(void (*callback)(void)) {
+                driverCallback = callback;
+            };
+            void (*getAutonomousCallback() const)(void) {
+                return autonomousCallback;
+            };
+            void (*getDriverCallback() const)(void) {
+                return driverCallback;
+            };
+            void setCompetitionMode(CompetitionMode mode) {
+                competitionMode = mode;
+            };
+            CompetitionMode getCompetitionMode() const {
+                return competitionMode;
+            };
+
+            /*
+            * Controller inputs. Events must be added in time order
+            */
+            void addControllerEvent(const ControllerEvent &event);
+            // load a script of lines "<milliseconds> <axis1> <axis2> <axis3> <axis4> <buttons>" where buttons is "-" or names joined with "+", e.g. "R2+Up".
+            // Times are relative to offsetMicros on the virtual clock
+            bool loadControllerScript(const char *path, uint64_t offsetMicros);
+
+            /*
+            * Screen and SD card
+            */
+            void screenPrint(const char *text);
+            void screenNewLine();
+            void screenSetRow(int32_t row) {
+                screenRow = row;
+            };
+            int32_t getScreenRow() const {
+                return screenRow;
+            };
+            void setEchoScreen(bool echo) {
+                echoScreen = echo;
+            };
+            uint64_t screenLineCount() const {
+                return screenLines;
+            };
+            // directory that stands in for the SD card, empty for no card
+            void setSdCardDirectory(const std::string &directory) {
+                sdCardDirectory = directory;
+            };
+            const std::string &getSdCardDirectory() const {
+                return sdCardDirectory;
+            };
+    };
+
+    // world of the calling thread. A thread that never set one uses a default world shared by such threads
+    World &currentWorld();
+    void setCurrentWorld(World *world);
+
+    // maximum speed (rpm) of a gear cartridge, and encoder counts per output shaft revolution
+    double cartridgeRpm(int gearSetting);
+    double cartridgeTicks(double maxRpm);
+
+    // reads a controller script (see World::loadControllerScript) and appends its events to events
+    bool readControllerScript(const char *path, uint64_t offsetMicros, std::vector<ControllerEvent> &events);
+}
+
+#endif
@@ -0,0 +1,128 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Work stealing thread pool that spreads independent jobs over all host cores
+* ------------------------------------------------------------------------
+*/
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <stddef.h>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vexhost {
+    /*
+    * WorkStealingPool class. run() hands jobs 0 .. count - 1 out to the workers in blocks, one queue per worker. Each worker takes jobs from
+    * the back of its own queue; once it is empty it steals from the front of the other queues, so workers that drew short jobs help the ones
+    * that drew long ones (routine 5 takes four times as long as routine 6) and every core stays busy until the last job.
+    * Every job is independent; the job function must be safe to call from several threads at once.
+    */
+    class WorkStealingPool {
+        public:
+            typedef void (*JobFunction)(void *context, size_t index);
+
+        private:
+            struct Queue {
+                std::mutex mutex;
+                std::deque<size_t> jobs;
+            };
+
+            unsigned int threads;
+            std::vector<Queue *> queues;
+            JobFunction function;
+            void *context;
+
+            bool popOwn(unsigned int worker, size_t &job) {
+                Queue &queue = *queues[worker];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.jobs.empty()) {
+                    return false;
+                }
+                job = queue.jobs.back();
+                queue.jobs.pop_back();
+                return true;
+            };
+
+            bool steal(unsigned int worker, size_t &job) {
+                for (unsigned int i = 1; i < threads; i++) {
+                    Queue &queue = *queues[(worker + i) % threads];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (!queue.jobs.empty()) {
+                        job = queue.jobs.front();
+                        queue.jobs.pop_front();
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            // no jobs are added while the pool runs, so a worker that finds every queue empty is done
+            void work(unsigned int worker) {
+                size_t job;
+                while (popOwn(worker, job) || steal(worker, job)) {
+                    function(context, job);
+                }
+            };
+
+        public:
+            // threads: number of workers, 0 for one per core
+            WorkStealingPool(unsigned int myThreads = 0) {
+                threads = myThreads ? myThreads : std::thread::hardware_concurrency();
+                if (threads == 0) {
+                    threads = 1;
+                }
+                for (unsigned int i = 0; i < threads; i++) {
+                    queues.push_back(new Queue());
+                }
+            };
+            ~WorkStealingPool() {
+                for (unsigned int i = 0; i < threads; i++) {
+                    delete queues[i];
+                }
+            };
+
+            /* ------------------------------------------------------------------------
+            * Function: run
+            * Desc: calls function(context, index) for every index in [0, count) on the workers. The calling thread works as one of them
+            * Param: number of jobs, job function, context pointer handed to it
+            * Output: returns once every job has finished
+            */
+            void run(size_t count, JobFunction myFunction, void *myContext) {
+                function = myFunction;
+                context = myContext;
+
+                // contiguous blocks, so a worker starts on jobs next to each other and only the stolen ones come from elsewhere
+                for (unsigned int i = 0; i < threads; i++) {
+                    size_t begin = count * i / threads;
+                    size_t end = count * (i + 1) / threads;
+                    for (size_t job = begin; job < end; job++) {
+                        queues[i]->jobs.push_back(job);
+                    }
+                }
+
+                std::vector<std::thread> workers;
+                for (unsigned int i = 1; i < threads; i++) {
+                    workers.push_back(std::thread(&WorkStealingPool::work, this, i));
+                }
+                work(0);
+                for (size_t i = 0; i < workers.size(); i++) {
+                    workers[i].join();
+                }
+            };
+
+            /*
+            * GET functions
+            */
+            unsigned int threadCount() const {
+                return threads;
+            };
+    };
+}
+
+#endif
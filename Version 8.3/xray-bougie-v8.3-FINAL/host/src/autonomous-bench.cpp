@@ -0,0 +1,118 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Autonomous benchmark. Runs autonomous routines 1 - 6 on the physics simulation and reports how long the routine and each of its
+*       primitives take, the time spent sleeping, settling and standing still, and how far from its target pose the robot ends up
+* ------------------------------------------------------------------------
+*/
+
+#include "routine-runner.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace vexhost;
+
+static void printDetails(const RoutineResult &result) {
+    printf("routine %d: ", result.routine);
+    if (result.finished) {
+        printf("%.3f s%s\n", result.seconds, result.seconds > routineWindow(result.routine) ? " (over the window)" : "");
+    } else {
+        printf("did not finish in %.1f s\n", result.seconds);
+    }
+
+    printf("  %-3s %-16s %9s %9s %9s %9s %9s\n", "#", "primitive", "argument", "start s", "time s", "settle s", "overshoot");
+    for (size_t i = 0; i < result.records.size(); i++) {
+        const RoutineProfiler::Record &record = result.records[i];
+        double start = record.startMicros / 1000000.0;
+        printf("  %-3d %-16s %9.3f %9.3f", (int) i + 1, record.name, record.argument, start - result.records[0].startMicros / 1000000.0);
+        if (record.endMicros == 0) {
+            printf(" %9s %9s %9s\n", "running", "-", "-");
+            continue;
+        }
+        printf(" %9.3f", (record.endMicros - record.startMicros) / 1000000.0);
+        if (record.settleMicros != 0) {
+            printf(" %9.3f", (record.endMicros - record.settleMicros) / 1000000.0);
+        } else {
+            printf(" %9s", "-");
+        }
+        printf(" %9.4g\n", record.overshoot);
+    }
+
+    printf("  sleeping %.3f s, settling %.3f s, base standing still %.3f s\n", result.sleepSeconds, result.settleSeconds, result.idleSeconds);
+    const ControlScheduler::Statistics &loop = result.loop;
+    printf("  control loop: %lu ticks, %lu overruns, busy max %.3f ms, period %.3f - %.3f ms, jitter rms %.3f ms max %.3f ms\n",
+           (unsigned long) loop.ticks, (unsigned long) loop.overruns, loop.maxBusyMicros / 1000.0, loop.minIntervalMicros / 1000.0,
+           loop.maxIntervalMicros / 1000.0, loop.rmsJitterMicros() / 1000, loop.maxJitterMicros / 1000.0);
+    printf("  end pose (%.3f, %.3f, %.1f deg), target (%.3f, %.3f, %.1f deg), error %.3f m %.1f deg, odometry off by %.3f m\n\n",
+           result.pose.x, result.pose.y, result.pose.heading, result.target.x, result.target.y, result.target.heading,
+           positionError(result.pose, result.target), result.pose.heading - result.target.heading, positionError(result.pose, result.odometry));
+}
+
+static void printSummary(const std::vector<RoutineResult> &results) {
+    printf("%-8s %9s %9s %9s %9s %9s %9s %9s %9s %9s\n", "routine", "total s", "window s", "sleep s", "settle s", "idle s", "error m", "error deg",
+           "overruns", "jitter ms");
+    for (size_t i = 0; i < results.size(); i++) {
+        const RoutineResult &result = results[i];
+        printf("%-8d %8.3f%s %9.0f %9.3f %9.3f %9.3f %9.3f %9.1f %9lu %9.3f\n", result.routine, result.seconds, result.finished ? " " : "+",
+               routineWindow(result.routine), result.sleepSeconds, result.settleSeconds, result.idleSeconds, positionError(result.pose, result.target),
+               result.pose.heading - result.target.heading, (unsigned long) result.loop.overruns, result.loop.rmsJitterMicros() / 1000);
+    }
+    printf("(+ did not finish within the time limit)\n");
+}
+
+static void usage(const char *program) {
+    printf("usage: %s [options]\n", program);
+    printf("  --routine N            benchmark only routine N (default %d - %d; %d checks the radius turns)\n", firstRoutine, lastRoutine,
+           radiusTurnRoutine);
+    printf("  --limit SECONDS        stop a routine that runs longer (default 60)\n");
+    printf("  --ideal                motors turn exactly at their commanded speed instead of running the physics simulation\n");
+    printf("  --battery VOLTS        battery voltage of the simulation (default 12.8)\n");
+    printf("  --summary              print only the summary table\n");
+    printf("  --trace DIRECTORY      write the Chrome trace of each routine to DIRECTORY/trace-routine-N.json (chrome://tracing, ui.perfetto.dev)\n");
+}
+
+int main(int argc, char **argv) {
+    int first = firstRoutine;
+    int last = lastRoutine;
+    double limitSeconds = 60;
+    bool ideal = false;
+    bool summary = false;
+    const char *traceDirectory = 0;
+    SimulationParameters parameters;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--routine") == 0 && i + 1 < argc) {
+            first = last = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            limitSeconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--ideal") == 0) {
+            ideal = true;
+        } else if (strcmp(argv[i], "--battery") == 0 && i + 1 < argc) {
+            parameters.batteryVoltage = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--summary") == 0) {
+            summary = true;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            traceDirectory = argv[++i];
+        } else {
+            usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    std::vector<RoutineResult> results;
+    for (int routine = first; routine <= last; routine++) {
+        char traceFile[512];
+        snprintf(traceFile, sizeof(traceFile), "%s/trace-routine-%d.json", traceDirectory, routine);
+        results.push_back(runRoutine(routine, limitSeconds, parameters, ideal, 0, traceDirectory ? traceFile : 0));
+        if (!summary) {
+            printDetails(results.back());
+        }
+    }
+    printSummary(results);
+    return 0;
+}
@@ -0,0 +1,215 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Monte Carlo sweep of the autonomous routines. Runs each routine many times on the physics simulation with randomized battery voltage,
+*       traction, weight, sonar noise and placement on the starting tile, spread over all cores, and reports the success rate, percentiles of
+*       the time to complete and the scatter of the final position
+* ------------------------------------------------------------------------
+*/
+
+#include "routine-runner.h"
+#include "work-stealing-pool.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace vexhost;
+
+struct SweepJob {
+    int routine;
+    int run;
+    SimulationParameters parameters;
+};
+
+struct SweepContext {
+    const std::vector<SweepJob> *jobs;
+    std::vector<RoutineResult> *results;
+    double limitSeconds;
+};
+
+static void sweepJob(void *context, size_t index) {
+    SweepContext &sweep = *static_cast<SweepContext *>(context);
+    const SweepJob &job = (*sweep.jobs)[index];
+    RoutineResult result = runRoutine(job.routine, sweep.limitSeconds, job.parameters, false);
+    result.records.clear(); // only the totals are aggregated
+    (*sweep.results)[index] = result;
+}
+
+// nearest rank percentile of sorted values
+static double percentile(const std::vector<double> &sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = (size_t) ceil(fraction * sorted.size());
+    return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+static double mean(const std::vector<double> &values) {
+    double sum = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        sum += values[i];
+    }
+    return values.empty() ? 0 : sum / values.size();
+}
+
+static double deviation(const std::vector<double> &values) {
+    double average = mean(values);
+    double sum = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        sum += (values[i] - average) * (values[i] - average);
+    }
+    return values.size() < 2 ? 0 : sqrt(sum / (values.size() - 1));
+}
+
+/* ------------------------------------------------------------------------
+* Function: printRoutine
+* Desc: aggregates the runs of one routine. A run succeeds if it finishes inside the routine's window and ends within the tolerances of its
+*       target pose. The scatter is the end position relative to the target
+* Param: results of the routine's runs, position tolerance (meters), heading tolerance (degrees)
+* Output: prints one block per routine
+*/
+static void printRoutine(const std::vector<const RoutineResult *> &runs, double tolerance, double headingTolerance) {
+    std::vector<double> seconds;
+    std::vector<double> errors;
+    std::vector<double> offsetsX;
+    std::vector<double> offsetsY;
+    std::vector<double> headingErrors;
+    int finished = 0;
+    int inWindow = 0;
+    int successes = 0;
+    for (size_t i = 0; i < runs.size(); i++) {
+        const RoutineResult &result = *runs[i];
+        double error = positionError(result.pose, result.target);
+        double headingError = result.pose.heading - result.target.heading;
+        bool fits = result.finished && result.seconds <= routineWindow(result.routine);
+
+        finished += result.finished ? 1 : 0;
+        inWindow += fits ? 1 : 0;
+        successes += (fits && error <= tolerance && fabs(headingError) <= headingTolerance) ? 1 : 0;
+        seconds.push_back(result.seconds);
+        errors.push_back(error);
+        offsetsX.push_back(result.pose.x - result.target.x);
+        offsetsY.push_back(result.pose.y - result.target.y);
+        headingErrors.push_back(headingError);
+    }
+    std::sort(seconds.begin(), seconds.end());
+    std::sort(errors.begin(), errors.end());
+
+    double count = runs.size();
+    printf("routine %d: %d runs, success %.1f%% (finished %.1f%%, inside the %.0f s window %.1f%%)\n", runs[0]->routine, (int) runs.size(),
+           100 * successes / count, 100 * finished / count, routineWindow(runs[0]->routine), 100 * inWindow / count);
+    printf("  time s     p10 %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n", percentile(seconds, 0.1), percentile(seconds, 0.5),
+           percentile(seconds, 0.9), percentile(seconds, 0.99), seconds.back());
+    printf("  error m    p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n", percentile(errors, 0.5), percentile(errors, 0.9), percentile(errors, 0.99),
+           errors.back());
+    printf("  scatter    x %+.3f +- %.3f m, y %+.3f +- %.3f m, heading %+.1f +- %.1f deg (mean +- standard deviation from the target)\n",
+           mean(offsetsX), deviation(offsetsX), mean(offsetsY), deviation(offsetsY), mean(headingErrors), deviation(headingErrors));
+}
+
+static bool writeCsv(const char *path, const std::vector<SweepJob> &jobs, const std::vector<RoutineResult> &results) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    fprintf(file, "routine,run,finished,seconds,x,y,heading,target_x,target_y,target_heading,battery,friction,slip,mass,start_x,start_y,start_heading\n");
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const SimulationParameters &p = jobs[i].parameters;
+        const RoutineResult &r = results[i];
+        fprintf(file, "%d,%d,%d,%.4f,%.4f,%.4f,%.2f,%.4f,%.4f,%.2f,%.3f,%.3f,%.4f,%.3f,%.4f,%.4f,%.2f\n", r.routine, jobs[i].run, r.finished ? 1 : 0,
+                r.seconds, r.pose.x, r.pose.y, r.pose.heading, r.target.x, r.target.y, r.target.heading, p.batteryVoltage, p.wheelFriction,
+                p.slipVelocity, p.mass, p.startX, p.startY, p.startHeading);
+    }
+    fclose(file);
+    return true;
+}
+
+static void usage(const char *program) {
+    printf("usage: %s [options]\n", program);
+    printf("  --routine N            sweep only routine N (default %d - %d)\n", firstRoutine, lastRoutine);
+    printf("  --runs N               randomized runs per routine (default 1000)\n");
+    printf("  --threads N            worker threads (default one per core)\n");
+    printf("  --seed N               seed of the randomized conditions (default 1)\n");
+    printf("  --limit SECONDS        stop a run that takes longer (default 60)\n");
+    printf("  --tolerance METERS     largest end position error of a successful run (default 0.1)\n");
+    printf("  --heading-tolerance D  largest end heading error of a successful run (default 10)\n");
+    printf("  --csv FILE             write every run (conditions and end pose) to a CSV file for plotting\n");
+}
+
+int main(int argc, char **argv) {
+    int first = firstRoutine;
+    int last = lastRoutine;
+    int runs = 1000;
+    unsigned int threads = 0;
+    unsigned int seed = 1;
+    double limitSeconds = 60;
+    double tolerance = 0.1;
+    double headingTolerance = 10;
+    const char *csv = 0;
+    Variation variation;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--routine") == 0 && i + 1 < argc) {
+            first = last = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = (unsigned int) atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (unsigned int) atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            limitSeconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--heading-tolerance") == 0 && i + 1 < argc) {
+            headingTolerance = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv = argv[++i];
+        } else {
+            usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (runs <= 0 || first > last) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<SweepJob> jobs;
+    for (int routine = first; routine <= last; routine++) {
+        for (int run = 0; run < runs; run++) {
+            SweepJob job = {routine, run, randomize(seed, routine, run, variation)};
+            jobs.push_back(job);
+        }
+    }
+    std::vector<RoutineResult> results(jobs.size());
+    SweepContext context = {&jobs, &results, limitSeconds};
+
+    WorkStealingPool pool(threads);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    pool.run(jobs.size(), sweepJob, &context);
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (int routine = first; routine <= last; routine++) {
+        std::vector<const RoutineResult *> routineRuns;
+        for (size_t i = 0; i < results.size(); i++) {
+            if (results[i].routine == routine) {
+                routineRuns.push_back(&results[i]);
+            }
+        }
+        printRoutine(routineRuns, tolerance, headingTolerance);
+    }
+    printf("%d runs in %.2f s on %u threads (%.0f runs / s)\n", (int) jobs.size(), wallSeconds, pool.threadCount(), jobs.size() / wallSeconds);
+
+    if (csv && !writeCsv(csv, jobs, results)) {
+        printf("could not write %s\n", csv);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,481 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Gain tuner. Searches kpLinear, kpRotational, the precision thresholds and the PID gains of the Robot for the least time, settling and
+*       overshoot of the autonomous routines on the physics simulation (Nelder-Mead), evaluates the candidates on all cores and writes the best
+*       gains to the generated header include/tuned-gains.h
+* ------------------------------------------------------------------------
+*/
+
+#include "routine-runner.h"
+#include "work-stealing-pool.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace vexhost;
+
+static const int gainCount = 17;
+
+/*
+* One searched gain: member of RobotGains, constant of tuned-gains.h, unit, and the range the search stays in.
+* The search works on the logarithm of the gains, so a step changes each of them by the same factor whatever its scale
+*/
+struct GainParameter {
+    const char *name;
+    const char *constant;
+    const char *unit;
+    double minimum;
+    double maximum;
+};
+
+static const GainParameter gainParameters[gainCount] = {
+    {"kpLinear", "tunedKpLinear", "percent per meter of wheel error", 0.5, 100},
+    {"kpRotational", "tunedKpRotational", "percent per base encoder degree of wheel error", 0.005, 2},
+    {"linearPrecisionThreshold", "tunedLinearPrecisionThreshold", "meters", 0.002, 0.05},
+    {"rotationalPrecisionThreshold", "tunedRotationalPrecisionThreshold", "base encoder degrees", 1, 40},
+    {"armPivotThreshold", "tunedArmPivotThreshold", "arm motor degrees", 1, 40},
+    {"linearPidKp", "tunedLinearPidKp", "percent per meter", 80, 8000},
+    {"linearPidKi", "tunedLinearPidKi", "percent per meter second", 5, 2000},
+    {"linearPidKd", "tunedLinearPidKd", "percent per meter / second", 1, 400},
+    {"rotationalPidKp", "tunedRotationalPidKp", "percent per base encoder degree", 0.04, 4},
+    {"rotationalPidKi", "tunedRotationalPidKi", "percent per base encoder degree second", 0.015, 6},
+    {"rotationalPidKd", "tunedRotationalPidKd", "percent per base encoder degree / second", 0.0005, 0.2},
+    {"armPidKp", "tunedArmPidKp", "percent per arm motor degree", 0.2, 20},
+    {"armPidKi", "tunedArmPidKi", "percent per arm motor degree second", 0.05, 20},
+    {"armPidKd", "tunedArmPidKd", "percent per arm motor degree / second", 0.001, 0.4},
+    {"rampPidKp", "tunedRampPidKp", "percent per ramp motor degree", 0.15, 15},
+    {"rampPidKi", "tunedRampPidKi", "percent per ramp motor degree second", 0.025, 10},
+    {"rampPidKd", "tunedRampPidKd", "percent per ramp motor degree / second", 0.0005, 0.2},
+};
+
+/*
+* Cost of one run, in seconds of routine time. A run costs the time the routine took, plus
+*   - settle: every second spent settling once more, so the tuner prefers motions that arrive at rest over ones that creep in
+*   - overshoot: per unit each motion went past its target (1 s for 2 cm, 15 base encoder degrees or about 2 degrees of heading, 30 arm degrees)
+*   - position / heading: per meter and degree the robot ends up from its target pose, so loose thresholds do not pay off
+*   - unfinished: a routine that did not finish within the time limit
+*/
+struct CostWeights {
+    double settle = 1;
+    double linearOvershoot = 50;
+    double rotationalOvershoot = 1.0 / 15;
+    double armOvershoot = 1.0 / 30;
+    double position = 50;
+    double heading = 0.5;
+    double unfinished = 30;
+};
+
+// sums over the routines of the mean over the conditions
+struct Score {
+    double cost;
+    double seconds;
+    double settleSeconds;
+    double overshoot; // cost of the overshoot (seconds)
+    double error; // end position error (meters)
+};
+
+struct TuneRun {
+    int routine;
+    SimulationParameters parameters;
+};
+
+struct TuneContext {
+    const std::vector<TuneRun> *runs;
+    const std::vector<RobotGains> *candidates;
+    std::vector<Score> *scores;
+    double limitSeconds;
+    CostWeights weights;
+};
+
+static void toArray(const RobotGains &gains, double *values) {
+    values[0] = gains.kpLinear;
+    values[1] = gains.kpRotational;
+    values[2] = gains.linearPrecisionThreshold;
+    values[3] = gains.rotationalPrecisionThreshold;
+    values[4] = gains.armPivotThreshold;
+    values[5] = gains.linearPidKp;
+    values[6] = gains.linearPidKi;
+    values[7] = gains.linearPidKd;
+    values[8] = gains.rotationalPidKp;
+    values[9] = gains.rotationalPidKi;
+    values[10] = gains.rotationalPidKd;
+    values[11] = gains.armPidKp;
+    values[12] = gains.armPidKi;
+    values[13] = gains.armPidKd;
+    values[14] = gains.rampPidKp;
+    values[15] = gains.rampPidKi;
+    values[16] = gains.rampPidKd;
+}
+
+static RobotGains fromArray(const double *values) {
+    RobotGains gains = {values[0], values[1], values[2], values[3], values[4], values[5], values[6], values[7], values[8], values[9], values[10],
+                        values[11], values[12], values[13], values[14], values[15], values[16]};
+    return gains;
+}
+
+// point of the search (logarithms of the gains), limited to the ranges of gainParameters
+static RobotGains toGains(const std::vector<double> &point) {
+    double values[gainCount];
+    for (int i = 0; i < gainCount; i++) {
+        values[i] = fmax(gainParameters[i].minimum, fmin(gainParameters[i].maximum, exp(point[i])));
+    }
+    return fromArray(values);
+}
+
+static std::vector<double> toPoint(const RobotGains &gains) {
+    double values[gainCount];
+    toArray(gains, values);
+    std::vector<double> point(gainCount);
+    for (int i = 0; i < gainCount; i++) {
+        point[i] = log(fmax(gainParameters[i].minimum, fmin(gainParameters[i].maximum, values[i])));
+    }
+    return point;
+}
+
+/* ------------------------------------------------------------------------
+* Function: scoreRun
+* Desc: cost of one run of a routine (see CostWeights)
+* Param: result of the run, weights
+* Output: returns the score of the run
+*/
+static Score scoreRun(const RoutineResult &result, const CostWeights &weights) {
+    Score score;
+    score.seconds = result.seconds;
+    score.settleSeconds = result.settleSeconds;
+    score.error = positionError(result.pose, result.target);
+    score.overshoot = 0;
+    for (size_t i = 0; i < result.records.size(); i++) {
+        const RoutineProfiler::Record &record = result.records[i];
+        if (strcmp(record.name, "linearMove") == 0) {
+            score.overshoot += record.overshoot * weights.linearOvershoot;
+        } else if (strcmp(record.name, "rotationalMove") == 0) {
+            score.overshoot += record.overshoot * weights.rotationalOvershoot;
+        } else if (strcmp(record.name, "armPivot") == 0) {
+            score.overshoot += record.overshoot * weights.armOvershoot;
+        }
+    }
+    score.cost = score.seconds + weights.settle * score.settleSeconds + score.overshoot + weights.position * score.error +
+                 weights.heading * fabs(result.pose.heading - result.target.heading) + (result.finished ? 0 : weights.unfinished);
+    return score;
+}
+
+// job index = candidate * runs + run
+static void tuneJob(void *context, size_t index) {
+    TuneContext &tune = *static_cast<TuneContext *>(context);
+    size_t runCount = tune.runs->size();
+    const TuneRun &run = (*tune.runs)[index % runCount];
+    const RobotGains &gains = (*tune.candidates)[index / runCount];
+    RoutineResult result = runRoutine(run.routine, tune.limitSeconds, run.parameters, false, &gains);
+    (*tune.scores)[index] = scoreRun(result, tune.weights);
+}
+
+/*
+* Tuner class. Evaluates batches of candidate gains on the same randomized runs, so the costs of two candidates differ only because of
+* their gains, and spreads the runs of a whole batch over the work stealing pool
+*/
+class Tuner {
+    private:
+        WorkStealingPool &pool;
+        std::vector<TuneRun> runs;
+        int conditions;
+        double limitSeconds;
+        CostWeights weights;
+        int evaluations;
+
+    public:
+        Tuner(WorkStealingPool &myPool, const std::vector<TuneRun> &myRuns, int myConditions, double myLimitSeconds)
+            : pool(myPool), runs(myRuns), conditions(myConditions), limitSeconds(myLimitSeconds), evaluations(0) {
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: evaluate
+        * Desc: runs every candidate on every run in parallel
+        * Param: candidate gains
+        * Output: returns the score of each candidate
+        */
+        std::vector<Score> evaluate(const std::vector<RobotGains> &candidates) {
+            std::vector<Score> runScores(candidates.size() * runs.size());
+            TuneContext context = {&runs, &candidates, &runScores, limitSeconds, weights};
+            pool.run(runScores.size(), tuneJob, &context);
+
+            std::vector<Score> scores(candidates.size());
+            for (size_t c = 0; c < candidates.size(); c++) {
+                Score total = {0, 0, 0, 0, 0};
+                for (size_t r = 0; r < runs.size(); r++) {
+                    const Score &score = runScores[c * runs.size() + r];
+                    total.cost += score.cost / conditions;
+                    total.seconds += score.seconds / conditions;
+                    total.settleSeconds += score.settleSeconds / conditions;
+                    total.overshoot += score.overshoot / conditions;
+                    total.error += score.error / conditions;
+                }
+                scores[c] = total;
+            }
+            evaluations += candidates.size();
+            return scores;
+        };
+
+        /*
+        * GET functions
+        */
+        int evaluationCount() const {
+            return evaluations;
+        };
+};
+
+struct Vertex {
+    std::vector<double> point;
+    Score score;
+};
+
+static bool lowerCost(const Vertex &a, const Vertex &b) {
+    return a.score.cost < b.score.cost;
+}
+
+// a + factor * (a - b)
+static std::vector<double> extend(const std::vector<double> &a, const std::vector<double> &b, double factor) {
+    std::vector<double> point(a.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        point[i] = a[i] + factor * (a[i] - b[i]);
+    }
+    return point;
+}
+
+// evaluates points of the search, limited to the gain ranges, in one parallel batch
+static std::vector<Vertex> evaluatePoints(Tuner &tuner, const std::vector<std::vector<double> > &points) {
+    std::vector<RobotGains> candidates;
+    for (size_t i = 0; i < points.size(); i++) {
+        candidates.push_back(toGains(points[i]));
+    }
+    std::vector<Score> scores = tuner.evaluate(candidates);
+    std::vector<Vertex> vertices(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        vertices[i].point = toPoint(candidates[i]);
+        vertices[i].score = scores[i];
+    }
+    return vertices;
+}
+
+/* ------------------------------------------------------------------------
+* Function: nelderMead
+* Desc: Nelder-Mead search from the start gains. Each iteration evaluates the reflected, expanded and both contracted points of the worst
+*       vertex together, so a step takes one parallel batch instead of up to three sequential evaluations
+* Param: tuner, start gains, factor of the first steps, iterations, cost difference of the simplex at which the search has converged
+* Output: returns the best vertex found
+*/
+static Vertex nelderMead(Tuner &tuner, const RobotGains &start, double step, int iterations, double tolerance) {
+    std::vector<double> origin = toPoint(start);
+    std::vector<std::vector<double> > points(1, origin);
+    for (int i = 0; i < gainCount; i++) {
+        std::vector<double> point = origin;
+        // step up, or down if the gain is already close to the top of its range
+        point[i] += log(step) * (exp(origin[i]) * step <= gainParameters[i].maximum ? 1 : -1);
+        points.push_back(point);
+    }
+    std::vector<Vertex> simplex = evaluatePoints(tuner, points);
+
+    for (int iteration = 1; iteration <= iterations; iteration++) {
+        std::sort(simplex.begin(), simplex.end(), lowerCost);
+        const Vertex &best = simplex[0];
+        Vertex &worst = simplex[gainCount];
+        printf("iteration %2d: best cost %.3f, simplex spread %.3f, %d candidates evaluated\n", iteration, best.score.cost,
+               worst.score.cost - best.score.cost, tuner.evaluationCount());
+        fflush(stdout);
+        if (worst.score.cost - best.score.cost < tolerance) {
+            break;
+        }
+
+        std::vector<double> centroid(gainCount, 0);
+        for (int v = 0; v < gainCount; v++) {
+            for (int i = 0; i < gainCount; i++) {
+                centroid[i] += simplex[v].point[i] / gainCount;
+            }
+        }
+        std::vector<std::vector<double> > trials;
+        trials.push_back(extend(centroid, worst.point, 1)); // reflected
+        trials.push_back(extend(centroid, worst.point, 2)); // expanded
+        trials.push_back(extend(centroid, worst.point, 0.5)); // contracted outside
+        trials.push_back(extend(centroid, worst.point, -0.5)); // contracted inside
+        std::vector<Vertex> trial = evaluatePoints(tuner, trials);
+        const Vertex &reflected = trial[0];
+        const Vertex &expanded = trial[1];
+        const Vertex &outside = trial[2];
+        const Vertex &inside = trial[3];
+
+        bool shrink = false;
+        if (reflected.score.cost < best.score.cost) {
+            worst = expanded.score.cost < reflected.score.cost ? expanded : reflected;
+        } else if (reflected.score.cost < simplex[gainCount - 1].score.cost) {
+            worst = reflected;
+        } else if (reflected.score.cost < worst.score.cost) {
+            if (outside.score.cost <= reflected.score.cost) {
+                worst = outside;
+            } else {
+                shrink = true;
+            }
+        } else if (inside.score.cost < worst.score.cost) {
+            worst = inside;
+        } else {
+            shrink = true;
+        }
+
+        if (shrink) {
+            std::vector<std::vector<double> > shrunk;
+            for (int v = 1; v <= gainCount; v++) {
+                shrunk.push_back(extend(simplex[0].point, simplex[v].point, -0.5));
+            }
+            std::vector<Vertex> vertices = evaluatePoints(tuner, shrunk);
+            for (int v = 1; v <= gainCount; v++) {
+                simplex[v] = vertices[v - 1];
+            }
+        }
+    }
+
+    std::sort(simplex.begin(), simplex.end(), lowerCost);
+    return simplex[0];
+}
+
+// one row per gain and score, the start gains next to the tuned ones
+static void printGains(const RobotGains &start, const Score &startScore, const RobotGains &tuned, const Score &tunedScore) {
+    double startValues[gainCount];
+    double tunedValues[gainCount];
+    toArray(start, startValues);
+    toArray(tuned, tunedValues);
+    printf("%-28s %10s %10s\n", "", "start", "tuned");
+    for (int i = 0; i < gainCount; i++) {
+        printf("%-28s %10.4g %10.4g\n", gainParameters[i].name, startValues[i], tunedValues[i]);
+    }
+    printf("%-28s %10.3f %10.3f\n", "cost", startScore.cost, tunedScore.cost);
+    printf("%-28s %10.3f %10.3f\n", "time s", startScore.seconds, tunedScore.seconds);
+    printf("%-28s %10.3f %10.3f\n", "settle s", startScore.settleSeconds, tunedScore.settleSeconds);
+    printf("%-28s %10.3f %10.3f\n", "overshoot", startScore.overshoot, tunedScore.overshoot);
+    printf("%-28s %10.3f %10.3f\n", "error m", startScore.error, tunedScore.error);
+}
+
+/* ------------------------------------------------------------------------
+* Function: writeHeader
+* Desc: writes the gains as the generated constants header the robot program includes
+* Param: path, gains, score of the gains and of the gains the search started from, routines and conditions they were scored on
+* Output: returns false if the file could not be written
+*/
+static bool writeHeader(const char *path, const RobotGains &gains, const Score &score, const Score &startScore, int first, int last,
+                        int conditions, unsigned int seed) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    char date[16];
+    time_t now = time(0);
+    strftime(date, sizeof(date), "%m/%d/%Y", localtime(&now));
+
+    double values[gainCount];
+    toArray(gains, values);
+    fprintf(file, "/*\n* ------------------------------------------------------------------------\n");
+    fprintf(file, "* Project: xray-bougie-v8.3\n* Author: Shaw-Sean Yang\n* Date: %s\n", date);
+    fprintf(file, "* Desc: Gains and precision thresholds of the Robot's autonomous motions and the gains of their PIDs. Generated by the gain tuner\n");
+    fprintf(file, "*       (host/src/gain-tuner.cpp, make tune in host/): rerun it instead of editing the values by hand\n");
+    fprintf(file, "* ------------------------------------------------------------------------\n*/\n\n");
+    fprintf(file, "#ifndef TUNED_GAINS_H\n#define TUNED_GAINS_H\n\n");
+    fprintf(file, "// tuned on the simulation over routines %d - %d in %d conditions (seed %u): cost %.3f, from %.3f\n", first, last, conditions, seed,
+            score.cost, startScore.cost);
+    for (int i = 0; i < gainCount; i++) {
+        fprintf(file, "static const double %s = %.4g; // %s\n", gainParameters[i].constant, values[i], gainParameters[i].unit);
+    }
+    fprintf(file, "\n#endif\n");
+    fclose(file);
+    return true;
+}
+
+static void usage(const char *program) {
+    printf("usage: %s [options]\n", program);
+    printf("  --routine N            tune on routine N only (default %d - %d)\n", firstRoutine, lastRoutine);
+    printf("  --conditions N         randomized conditions each routine runs in per candidate (default 4)\n");
+    printf("  --iterations N         Nelder-Mead iterations (default 30)\n");
+    printf("  --threads N            worker threads (default one per core)\n");
+    printf("  --seed N               seed of the randomized conditions (default 1)\n");
+    printf("  --limit SECONDS        stop a run that takes longer (default 60)\n");
+    printf("  --output FILE          generated header (default ../include/tuned-gains.h)\n");
+    printf("  --dry-run              print the tuned gains without writing the header\n");
+}
+
+int main(int argc, char **argv) {
+    int first = firstRoutine;
+    int last = lastRoutine;
+    int conditions = 4;
+    int iterations = 30;
+    unsigned int threads = 0;
+    unsigned int seed = 1;
+    double limitSeconds = 60;
+    const char *output = "../include/tuned-gains.h";
+    bool dryRun = false;
+    Variation variation;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--routine") == 0 && i + 1 < argc) {
+            first = last = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--conditions") == 0 && i + 1 < argc) {
+            conditions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = (unsigned int) atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (unsigned int) atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            limitSeconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--dry-run") == 0) {
+            dryRun = true;
+        } else {
+            usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (conditions <= 0 || iterations < 0 || first > last) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // every candidate runs in the same conditions
+    std::vector<TuneRun> runs;
+    for (int routine = first; routine <= last; routine++) {
+        for (int run = 0; run < conditions; run++) {
+            TuneRun tuneRun = {routine, randomize(seed, routine, run, variation)};
+            runs.push_back(tuneRun);
+        }
+    }
+
+    WorkStealingPool pool(threads);
+    Tuner tuner(pool, runs, conditions, limitSeconds);
+    RobotGains start = tunedGains();
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    Score startScore = tuner.evaluate(std::vector<RobotGains>(1, start))[0];
+    Vertex best = nelderMead(tuner, start, 1.5, iterations, 0.01);
+    RobotGains gains = toGains(best.point);
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    printf("\n");
+    printGains(start, startScore, gains, best.score);
+    printf("%d candidates, %d runs in %.1f s on %u threads\n", tuner.evaluationCount(), tuner.evaluationCount() * (int) runs.size(), wallSeconds,
+           pool.threadCount());
+
+    if (!dryRun) {
+        if (!writeHeader(output, gains, best.score, startScore, first, last, conditions, seed)) {
+            printf("could not write %s\n", output);
+            return 1;
+        }
+        printf("wrote %s\n", output);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Host harness. Plays field control for the robot program built against the vex:: stand-in: runs main(), then the autonomous and
+*       driver control callbacks it registers, on the virtual clock
+* ------------------------------------------------------------------------
+*/
+
+#include "v5_vcs.h"
+#include "vex-host.h"
+#include "robot-sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// main() of src/main.cpp, renamed by the host makefile
+int vexUserMain();
+
+static int userMainTask(void *) {
+    vexUserMain();
+    return 0;
+}
+
+static int autonomousTask(void *) {
+    vexhost::currentWorld().getAutonomousCallback()();
+    return 0;
+}
+
+static int driverTask(void *) {
+    vexhost::currentWorld().getDriverCallback()();
+    return 0;
+}
+
+static void usage(const char *program) {
+    printf("usage: %s [options]\n", program);
+    printf("  --autonomous SECONDS   length of the autonomous period (default 15, 0 to skip)\n");
+    printf("  --driver SECONDS       length of the driver control period (default 105, 0 to skip)\n");
+    printf("  --script FILE          controller inputs during driver control, lines \"<ms> <axis1> <axis2> <axis3> <axis4> <buttons>\"\n");
+    printf("  --sdcard DIRECTORY     directory that stands in for the SD card\n");
+    printf("  --screen               print the brain screen to stdout\n");
+    printf("  --ideal                motors turn exactly at their commanded speed instead of running the physics simulation\n");
+    printf("  --battery VOLTS        battery voltage of the simulation (default 12.8)\n");
+}
+
+/* ------------------------------------------------------------------------
+* Function: runPeriod
+* Desc: starts a competition callback in its own task, like field control does, and stops it when the period ends
+* Param: competition mode, task function running the callback, length of the period (seconds)
+* Output: none
+*/
+static void runPeriod(vexhost::CompetitionMode mode, vexhost::World::TaskFunction function, double seconds) {
+    vexhost::World &world = vexhost::currentWorld();
+    world.setCompetitionMode(mode);
+    int32_t id = world.startTask(function, 0, vex::task::taskPriorityNormal);
+    vex::task::sleep((uint32_t) (seconds * 1000));
+    world.stopTask(id);
+    world.setCompetitionMode(vexhost::MODE_DISABLED);
+}
+
+int main(int argc, char **argv) {
+    double autonomousSeconds = 15;
+    double driverSeconds = 105;
+    const char *script = 0;
+    bool ideal = false;
+    vexhost::SimulationParameters parameters;
+
+    vexhost::World &world = vexhost::currentWorld();
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--autonomous") == 0 && i + 1 < argc) {
+            autonomousSeconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--driver") == 0 && i + 1 < argc) {
+            driverSeconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            script = argv[++i];
+        } else if (strcmp(argv[i], "--sdcard") == 0 && i + 1 < argc) {
+            world.setSdCardDirectory(argv[++i]);
+        } else if (strcmp(argv[i], "--screen") == 0) {
+            world.setEchoScreen(true);
+        } else if (strcmp(argv[i], "--ideal") == 0) {
+            ideal = true;
+        } else if (strcmp(argv[i], "--battery") == 0 && i + 1 < argc) {
+            parameters.batteryVoltage = atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    vexhost::RobotSimulation simulation(parameters);
+    if (!ideal) {
+        world.setPhysics(&simulation);
+    }
+
+    // pre-autonomous: main() registers the competition callbacks, then idles in its own task
+    world.startTask(userMainTask, 0, vex::task::taskPriorityNormal);
+    vex::task::sleep(20);
+
+    if (autonomousSeconds > 0 && world.getAutonomousCallback()) {
+        runPeriod(vexhost::MODE_AUTONOMOUS, autonomousTask, autonomousSeconds);
+    }
+    if (driverSeconds > 0 && world.getDriverCallback()) {
+        if (script && !world.loadControllerScript(script, world.currentMicros())) {
+            printf("could not read controller script %s\n", script);
+        }
+        runPeriod(vexhost::MODE_DRIVER, driverTask, driverSeconds);
+    }
+
+    printf("virtual time %.3f s, %llu screen lines\n", world.currentMicros() / 1000000.0, (unsigned long long) world.screenLineCount());
+    for (int i = 0; i < vexhost::motorPorts; i++) {
+        if (world.motors[i].installed) {
+            printf("PORT%-2d %9.1f deg %6.1f C\n", i + 1, world.motors[i].position, world.motors[i].temperature);
+        }
+    }
+    if (!ideal) {
+        const vexhost::ChassisState &chassis = simulation.getChassis();
+        printf("pose x %.3f m, y %.3f m, heading %.1f deg\n", chassis.x, chassis.y, chassis.heading);
+    }
+
+    world.shutdown();
+    return 0;
+}
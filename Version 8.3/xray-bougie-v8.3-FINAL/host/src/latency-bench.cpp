@@ -0,0 +1,216 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Input latency benchmark. Runs the driver loop on scripted controller inputs and reports, per subsystem, the time from each change of
+*       the inputs to the motor command driverMain sends for it
+* ------------------------------------------------------------------------
+*/
+
+#include "routine-runner.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace vexhost;
+
+/* ------------------------------------------------------------------------
+* Function: generateScript
+* Desc: makes up a driver: every 80 - 400 ms (at any microsecond, not on a control tick) it changes the inputs of one subsystem: the sticks
+*       or X / B of the base, R1 / R2 / A of the intake, Up / Right / Down of the arm, or L1 / L2 of the ramp
+* Param: length of the script (seconds), seed
+* Output: returns the controller events in time order
+*/
+static std::vector<ControllerEvent> generateScript(double seconds, unsigned int seed) {
+    static const Button intakeButtons[] = {BUTTON_R1, BUTTON_R2, BUTTON_A};
+    static const Button armButtons[] = {BUTTON_UP, BUTTON_RIGHT, BUTTON_DOWN};
+    static const Button rampButtons[] = {BUTTON_L1, BUTTON_L2};
+    static const Button baseButtons[] = {BUTTON_X, BUTTON_B};
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::vector<ControllerEvent> script;
+    ControllerEvent event;
+    event.micros = 0;
+    for (int i = 0; i < 4; i++) {
+        event.state.axis[i] = 0;
+    }
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        event.state.buttons[i] = false;
+    }
+
+    uint64_t end = (uint64_t) (seconds * 1000000);
+    while (true) {
+        event.micros += 80000 + (uint64_t) (320000 * uniform(generator));
+        if (event.micros >= end) {
+            break;
+        }
+        // one button of the group (or none) is held, like a driver does
+        const Button *group;
+        int size;
+        int subsystem = (int) (4 * uniform(generator));
+        if (subsystem == 0 && uniform(generator) < 0.7) {
+            event.state.axis[2] = uniform(generator) < 0.2 ? 0 : (int) (200 * uniform(generator)) - 100;
+            event.state.axis[0] = uniform(generator) < 0.5 ? 0 : (int) (200 * uniform(generator)) - 100;
+            script.push_back(event);
+            continue;
+        } else if (subsystem == 0) {
+            group = baseButtons;
+            size = 2;
+        } else if (subsystem == 1) {
+            group = intakeButtons;
+            size = 3;
+        } else if (subsystem == 2) {
+            group = armButtons;
+            size = 3;
+        } else {
+            group = rampButtons;
+            size = 2;
+        }
+        int held = (int) ((size + 1) * uniform(generator));
+        for (int i = 0; i < size; i++) {
+            event.state.buttons[group[i]] = i == held;
+        }
+        script.push_back(event);
+    }
+    return script;
+}
+
+// time (microseconds) of the last scripted event at or before the given time, the change the robot saw in its snapshot
+static uint64_t changeMicros(const std::vector<ControllerEvent> &script, uint64_t micros) {
+    uint64_t change = 0;
+    size_t low = 0;
+    size_t high = script.size();
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (script[middle].micros <= micros) {
+            change = script[middle].micros;
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return change;
+}
+
+static double percentile(const std::vector<double> &sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = (size_t) (fraction * sorted.size());
+    return sorted[index < sorted.size() ? index : sorted.size() - 1];
+}
+
+static double mean(const std::vector<double> &values) {
+    double sum = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        sum += values[i];
+    }
+    return values.empty() ? 0 : sum / values.size();
+}
+
+static void usage(const char *program) {
+    printf("usage: %s [options]\n", program);
+    printf("  --seconds SECONDS      length of the driver run (default 60)\n");
+    printf("  --seed N               seed of the generated controller inputs (default 1)\n");
+    printf("  --script FILE          controller inputs instead of generated ones, lines \"<ms> <axis1> <axis2> <axis3> <axis4> <buttons>\"\n");
+    printf("  --ideal                motors turn exactly at their commanded speed instead of running the physics simulation\n");
+    printf("  --battery VOLTS        battery voltage of the simulation (default 12.8)\n");
+    printf("  --csv FILE             write every sample (subsystem, change, snapshot and command time) to FILE\n");
+    printf("\n");
+    printf("in loop: from the sensor snapshot that saw the change to the command, as the robot measures it. Computation takes no virtual time\n");
+    printf("on the host, so only blocking in the driver loop shows up there. end to end: from the scripted change to the command, which adds\n");
+    printf("the wait for the next control tick\n");
+}
+
+int main(int argc, char **argv) {
+    double seconds = 60;
+    unsigned int seed = 1;
+    const char *scriptFile = 0;
+    const char *csvFile = 0;
+    bool ideal = false;
+    SimulationParameters parameters;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (unsigned int) atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            scriptFile = argv[++i];
+        } else if (strcmp(argv[i], "--ideal") == 0) {
+            ideal = true;
+        } else if (strcmp(argv[i], "--battery") == 0 && i + 1 < argc) {
+            parameters.batteryVoltage = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csvFile = argv[++i];
+        } else {
+            usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    std::vector<ControllerEvent> script;
+    if (scriptFile) {
+        if (!readControllerScript(scriptFile, 0, script)) {
+            fprintf(stderr, "cannot read %s\n", scriptFile);
+            return 1;
+        }
+    } else {
+        script = generateScript(seconds, seed);
+    }
+
+    DriverResult result = runDriver(seconds, script, parameters, ideal);
+
+    FILE *csv = 0;
+    if (csvFile) {
+        csv = fopen(csvFile, "w");
+        if (!csv) {
+            fprintf(stderr, "cannot write %s\n", csvFile);
+            return 1;
+        }
+        fprintf(csv, "subsystem,change_ms,snapshot_ms,command_ms\n");
+    }
+    std::vector<double> endToEnd[LatencyMeter::maxChannels];
+    for (size_t i = 0; i < result.samples.size(); i++) {
+        const LatencyMeter::Sample &sample = result.samples[i];
+        uint64_t change = changeMicros(script, sample.inputMicros);
+        endToEnd[sample.channel].push_back((sample.outputMicros - change) / 1000.0);
+        if (csv) {
+            fprintf(csv, "%s,%.3f,%.3f,%.3f\n", result.channelNames[sample.channel], change / 1000.0, sample.inputMicros / 1000.0,
+                    sample.outputMicros / 1000.0);
+        }
+    }
+    if (csv) {
+        fclose(csv);
+    }
+
+    printf("driver loop: %.1f s, %zu scripted input changes, %lu ticks, %lu overruns, busy max %.3f ms, jitter rms %.3f ms\n", result.seconds,
+           script.size(), (unsigned long) result.loop.ticks, (unsigned long) result.loop.overruns, result.loop.maxBusyMicros / 1000.0,
+           result.loop.rmsJitterMicros() / 1000);
+    printf("input handlers: %lu calls, %lu skipped with no input change\n", (unsigned long) result.handlerCalls, (unsigned long) result.handlerSkips);
+    printf("%-8s %8s | %-29s | %s\n", "", "", "in loop ms", "end to end ms");
+    printf("%-8s %8s | %6s %6s %6s %7s | %6s %6s %6s %6s %7s\n", "system", "changes", "mean", "p50", "p99", "max", "mean", "p50", "p90", "p99", "max");
+    for (int i = 0; i < LatencyMeter::maxChannels; i++) {
+        const LatencyMeter::Statistics &stats = result.latency[i];
+        if (!result.channelNames[i]) {
+            continue;
+        }
+        std::vector<double> &latencies = endToEnd[i];
+        std::sort(latencies.begin(), latencies.end());
+        printf("%-8s %8lu | %6.3f %6.3f %6.3f %7.3f | %6.3f %6.3f %6.3f %6.3f %7.3f\n", result.channelNames[i], (unsigned long) stats.count,
+               stats.meanMicros() / 1000, stats.percentileMicros(0.5) / 1000, stats.percentileMicros(0.99) / 1000, stats.maxMicros / 1000.0,
+               mean(latencies), percentile(latencies, 0.5), percentile(latencies, 0.9), percentile(latencies, 0.99),
+               latencies.empty() ? 0 : latencies.back());
+    }
+    if (result.droppedSamples > 0) {
+        printf("(%lu samples did not fit into the meter, end to end covers the first %zu)\n", (unsigned long) result.droppedSamples,
+               result.samples.size());
+    }
+    return 0;
+}
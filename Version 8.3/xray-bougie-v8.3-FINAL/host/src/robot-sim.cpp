@@ -0,0 +1,265 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Time stepped physics simulation of the X-Ray Bougie Bot for the host build
+* ------------------------------------------------------------------------
+*/
+
+#include "robot-sim.h"
+
+#include <math.h>
+
+namespace vexhost {
+    static const double gravityAcceleration = 9.81;
+    static const double noEchoMillimeters = 9999;
+
+    // speeds that decay towards zero would end up as denormal numbers, which are very slow to compute with
+    static double flushTiny(double value) {
+        return fabs(value) < 1e-12 ? 0 : value;
+    }
+
+    RobotSimulation::RobotSimulation(const SimulationParameters &myParameters) {
+        parameters = myParameters;
+        chassis.x = parameters.startX;
+        chassis.y = parameters.startY;
+        chassis.heading = parameters.startHeading;
+        chassis.velocity = 0;
+        chassis.angularVelocity = 0;
+        for (int i = 0; i < motorPorts; i++) {
+            shaftVelocity[i] = 0;
+        }
+        noiseState = parameters.seed ? parameters.seed : 1;
+    }
+
+    /* ------------------------------------------------------------------------
+    * Function: motorTorque
+    * Desc: voltage the motor applies for its command, and the torque and current that gives at the shaft speed. Also heats the winding
+    * Param: the motor, speed of the output shaft (rad/s, motor's own direction), time step (seconds)
+    * Output: torque at the output shaft (Nm)
+    */
+    double RobotSimulation::motorTorque(MotorState &motor, double omega, double dt) {
+        double freeSpeed = motor.maxRpm * 2 * M_PI / 60; // at maxVoltage
+        double stallTorque = parameters.stallTorque36 * 100 / motor.maxRpm;
+        double supply = fmin(parameters.maxVoltage, parameters.batteryVoltage - 0.8);
+
+        double voltage = 0;
+        bool open = false;
+        if (motor.mode == MOTOR_VELOCITY) {
+            double target = fmax(-motor.maxRpm, fmin(motor.maxRpm, motor.command)) * 2 * M_PI / 60;
+            voltage = parameters.maxVoltage * (target + parameters.velocityGain * (target - omega)) / freeSpeed;
+        } else if (motor.mode == MOTOR_VOLTAGE) {
+            voltage = motor.command;
+        } else if (motor.stopping == STOP_HOLD) {
+            voltage = parameters.holdGain * (motor.holdPosition - motor.position) - parameters.holdDamping * omega * 180 / M_PI;
+        } else if (motor.stopping == STOP_COAST) {
+            open = true;
+        }
+        voltage = fmax(-supply, fmin(supply, voltage));
+
+        double torque = 0;
+        double current = 0;
+        if (!open) {
+            torque = stallTorque * (voltage - parameters.maxVoltage * omega / freeSpeed) / parameters.maxVoltage;
+            current = parameters.stallCurrent * torque / stallTorque;
+
+            double currentLimit = parameters.stallCurrent * motor.maxTorquePercent / 100;
+            if (fabs(current) > currentLimit) {
+                current = copysign(currentLimit, current);
+                torque = stallTorque * current / parameters.stallCurrent;
+            }
+        }
+
+        double heating = current * current * parameters.windingResistance;
+        double cooling = (motor.temperature - parameters.ambientTemperature) / parameters.thermalResistance;
+        motor.temperature += (heating - cooling) / parameters.thermalCapacity * dt;
+
+        motor.voltage = open ? 0 : voltage;
+        motor.current = fabs(current);
+        motor.torque = torque;
+        return torque;
+    };
+
+    /* ------------------------------------------------------------------------
+    * Function: stepDrive
+    * Desc: advances the drive by one substep. Each side's wheels are driven by its two motors and push on the chassis through traction
+    * Param: world, time step (seconds)
+    * Output: none
+    */
+    void RobotSimulation::stepDrive(World &world, double dt) {
+        MotorState &topLeft = world.motors[parameters.baseTopLeftPort];
+        MotorState &bottomLeft = world.motors[parameters.baseBottomLeftPort];
+        MotorState &topRight = world.motors[parameters.baseTopRightPort];
+        MotorState &bottomRight = world.motors[parameters.baseBottomRightPort];
+
+        double wheelRadius = parameters.wheelCircumference / (2 * M_PI);
+        double gearing = parameters.motorDegreesPerWheelRotation / 360 / wheelRadius; // motor rad/s per m/s of wheel surface
+
+        // right motors turn in reverse to drive forward
+        double leftOmega = leftWheelVelocity * gearing;
+        double rightOmega = -rightWheelVelocity * gearing;
+        double leftForce = (motorTorque(topLeft, leftOmega, dt) + motorTorque(bottomLeft, leftOmega, dt)) * gearing;
+        double rightForce = -(motorTorque(topRight, rightOmega, dt) + motorTorque(bottomRight, rightOmega, dt)) * gearing;
+
+        double angularVelocity = chassis.angularVelocity * M_PI / 180;
+        double leftGround = chassis.velocity + angularVelocity * parameters.trackWidth / 2;
+        double rightGround = chassis.velocity - angularVelocity * parameters.trackWidth / 2;
+        double maxTraction = parameters.wheelFriction * parameters.mass * gravityAcceleration / 2;
+        double leftTraction = maxTraction * tanh((leftWheelVelocity - leftGround) / parameters.slipVelocity);
+        double rightTraction = maxTraction * tanh((rightWheelVelocity - rightGround) / parameters.slipVelocity);
+
+        leftWheelVelocity = flushTiny(leftWheelVelocity + (leftForce - leftTraction) / parameters.sideWheelMass * dt);
+        rightWheelVelocity = flushTiny(rightWheelVelocity + (rightForce - rightTraction) / parameters.sideWheelMass * dt);
+
+        double rolling = parameters.rollingResistance * parameters.mass * gravityAcceleration * tanh(chassis.velocity / 0.01);
+        double scrub = parameters.scrubTorque * tanh(angularVelocity / 0.1);
+        chassis.velocity = flushTiny(chassis.velocity + (leftTraction + rightTraction - rolling) / parameters.mass * dt);
+        angularVelocity = flushTiny(angularVelocity + ((leftTraction - rightTraction) * parameters.trackWidth / 2 - scrub) / parameters.yawInertia * dt);
+        chassis.angularVelocity = angularVelocity * 180 / M_PI;
+
+        double heading = chassis.heading * M_PI / 180;
+        chassis.x += chassis.velocity * cos(heading) * dt;
+        chassis.y += chassis.velocity * sin(heading) * dt;
+        chassis.heading += chassis.angularVelocity * dt;
+
+        leftOmega = leftWheelVelocity * gearing;
+        rightOmega = -rightWheelVelocity * gearing;
+        MotorState *motors[4] = {&topLeft, &bottomLeft, &topRight, &bottomRight};
+        double omegas[4] = {leftOmega, leftOmega, rightOmega, rightOmega};
+        for (int i = 0; i < 4; i++) {
+            motors[i]->velocity = omegas[i] * 60 / (2 * M_PI);
+            motors[i]->position += omegas[i] * 180 / M_PI * dt;
+        }
+    };
+
+    /* ------------------------------------------------------------------------
+    * Function: stepShaft
+    * Desc: advances a motor that turns a single inertia (arm, ramp, intake roller) by one substep
+    * Param: world, port, inertia (kg m^2), external torque such as gravity (Nm), viscous friction (Nm / (rad / s)),
+    *        hard stops (motor degrees), time step (seconds)
+    * Output: none
+    */
+    void RobotSimulation::stepShaft(World &world, int port, double inertia, double gravity, double friction, double minimum, double maximum, double dt) {
+        MotorState &motor = world.motors[port];
+        double &omega = shaftVelocity[port];
+
+        double torque = motorTorque(motor, omega, dt);
+        omega = flushTiny(omega + (torque + gravity - friction * omega) / inertia * dt);
+        motor.position += omega * 180 / M_PI * dt;
+
+        if (motor.position < minimum) {
+            motor.position = minimum;
+            omega = fmax(omega, 0);
+        } else if (motor.position > maximum) {
+            motor.position = maximum;
+            omega = fmin(omega, 0);
+        }
+        motor.velocity = omega * 60 / (2 * M_PI);
+    };
+
+    /* ------------------------------------------------------------------------
+    * Function: step
+    * Desc: advances every installed motor, the chassis and the sonars by one world step
+    * Param: world, time step (seconds)
+    * Output: none
+    */
+    void RobotSimulation::step(World &world, double dt) {
+        const SimulationParameters &p = parameters;
+        int substeps = p.substeps > 0 ? p.substeps : 1;
+        double h = dt / substeps;
+
+        for (int n = 0; n < substeps; n++) {
+            stepDrive(world, h);
+
+            for (int i = 0; i < motorPorts; i++) {
+                if (!world.motors[i].installed || i == p.baseTopLeftPort || i == p.baseBottomLeftPort || i == p.baseTopRightPort ||
+                    i == p.baseBottomRightPort) {
+                    continue;
+                }
+
+                if (i == p.armPivotPort) {
+                    double gravity = -p.armGravityTorque * cos(armAngle(world) * M_PI / 180);
+                    stepShaft(world, i, p.armInertia, gravity, p.jointFriction, p.armMinimum, p.armMaximum, h);
+                } else if (i == p.rampLiftPort) {
+                    // lifting the ramp upright takes negative motor angles
+                    double gravity = p.rampGravityTorque * cos(rampAngle(world) * M_PI / 180);
+                    stepShaft(world, i, p.rampInertia, gravity, p.jointFriction, p.rampMinimum, p.rampMaximum, h);
+                } else {
+                    stepShaft(world, i, p.intakeInertia, 0, p.intakeFriction, -HUGE_VAL, HUGE_VAL, h);
+                }
+            }
+        }
+
+        updateSonars(world);
+    };
+
+    double RobotSimulation::armAngle(const World &world) const {
+        return parameters.armStartAngle + world.motors[parameters.armPivotPort].position / parameters.armRatio;
+    };
+
+    double RobotSimulation::rampAngle(const World &world) const {
+        return parameters.rampStartAngle - world.motors[parameters.rampLiftPort].position / parameters.rampRatio;
+    };
+
+    /* ------------------------------------------------------------------------
+    * Function: updateSonars
+    * Desc: measures the distance from each sonar to the field wall it faces
+    * Param: world
+    * Output: none
+    */
+    void RobotSimulation::updateSonars(World &world) {
+        const SimulationParameters &p = parameters;
+        double startHeading = p.startFieldHeading * M_PI / 180;
+        double x = p.startFieldX + chassis.x * cos(startHeading) - chassis.y * sin(startHeading);
+        double y = p.startFieldY + chassis.x * sin(startHeading) + chassis.y * cos(startHeading);
+        double heading = p.startFieldHeading + chassis.heading;
+
+        int ports[3] = {p.backSonarPort, p.rightSonarPort, p.leftSonarPort};
+        double directions[3] = {180, 90, -90};
+        for (int i = 0; i < 3; i++) {
+            double direction = (heading + directions[i]) * M_PI / 180;
+            double distance = castRay(x + p.sonarOffset * cos(direction), y + p.sonarOffset * sin(direction), direction);
+            if (distance > p.sonarMaxRange) {
+                world.sonarMillimeters[ports[i]] = noEchoMillimeters;
+            } else {
+                world.sonarMillimeters[ports[i]] = fmax(0, distance + gaussian() * p.sonarNoise) * 1000;
+            }
+        }
+    };
+
+    /* ------------------------------------------------------------------------
+    * Function: castRay
+    * Desc: distance from a point on the field to the wall in a direction
+    * Param: field point (meters), direction (radians)
+    * Output: distance (meters)
+    */
+    double RobotSimulation::castRay(double x, double y, double direction) const {
+        double dx = cos(direction);
+        double dy = sin(direction);
+        double distance = HUGE_VAL;
+        if (dx > 1e-9) {
+            distance = fmin(distance, (parameters.fieldSize - x) / dx);
+        } else if (dx < -1e-9) {
+            distance = fmin(distance, -x / dx);
+        }
+        if (dy > 1e-9) {
+            distance = fmin(distance, (parameters.fieldSize - y) / dy);
+        } else if (dy < -1e-9) {
+            distance = fmin(distance, -y / dy);
+        }
+        return fmax(0, distance);
+    };
+
+    // standard normal sample from a xorshift generator (Box-Muller), so runs with the same seed repeat exactly
+    double RobotSimulation::gaussian() {
+        double u[2];
+        for (int i = 0; i < 2; i++) {
+            noiseState ^= noiseState << 13;
+            noiseState ^= noiseState >> 17;
+            noiseState ^= noiseState << 5;
+            u[i] = (noiseState + 1.0) / 4294967297.0;
+        }
+        return sqrt(-2 * log(u[0])) * cos(2 * M_PI * u[1]);
+    };
+}
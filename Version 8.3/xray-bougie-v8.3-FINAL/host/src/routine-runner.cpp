@@ -0,0 +1,200 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Runs one autonomous routine of the robot program from rest in a world of its own, for the benchmark, the sweep and the gain tuner,
+*       and the driver loop on scripted controller inputs for the latency benchmark
+* ------------------------------------------------------------------------
+*/
+
+#include "vex-host.h"
+#include "routine-runner.h"
+
+// the robot program is compiled in here so every run can construct its own Robot. Its main() is renamed like in the host build
+#define main vexUserMain
+#include "../../src/main.cpp"
+#undef main
+
+#include <random>
+
+/*
+* Check routines of the bench, which drive the robot's motion primitives like a routine of autonomousMain
+*/
+class BenchRoutines {
+    public:
+        static void radiusTurns(Robot &robot) {
+            int routineTrace = robot.startRoutine(vexhost::radiusTurnRoutine);
+            robot.rotationalMove(0.5, 90, 0.4);
+            robot.rotationalMove(0.5, -90, 0.4);
+            robot.rotationalMove(0.5, 0, 0.4); // no turn, finishes right away
+            robot.rotationalMove(0.3, -180, 0.3);
+            robot.finishRoutine(vexhost::radiusTurnRoutine, routineTrace);
+        };
+};
+
+namespace vexhost {
+    struct RoutineRun {
+        Robot *robot;
+        int routine;
+        bool finished;
+    };
+
+    static int driverTask(void *robot) {
+        static_cast<Robot *>(robot)->driverMain();
+        return 0;
+    }
+
+    static bool writeTraceFile(void *context, const uint8_t *data, uint32_t length, bool) {
+        return fwrite(data, 1, length, static_cast<FILE *>(context)) == length;
+    }
+
+    static int routineTask(void *argument) {
+        RoutineRun *run = static_cast<RoutineRun *>(argument);
+        if (run->routine == radiusTurnRoutine) {
+            BenchRoutines::radiusTurns(*run->robot);
+        } else {
+            run->robot->autonomousMain(run->routine);
+        }
+        run->finished = true;
+        return 0;
+    }
+
+    RoutineResult runRoutine(int routine, double limitSeconds, const SimulationParameters &parameters, bool ideal, const RobotGains *gains, const char *traceFile) {
+        // the global device handles were constructed in the default world, which threads that never set a world of their own share
+        World &defaults = currentWorld();
+        World world;
+        world.installDevices(defaults);
+        RobotSimulation simulation(parameters);
+        if (!ideal) {
+            world.setPhysics(&simulation);
+        }
+        setCurrentWorld(&world);
+
+        Robot *robot = new Robot();
+        if (gains) {
+            robot->setGains(*gains);
+        }
+        RoutineRun run = {robot, routine, false};
+        uint64_t limit = (uint64_t) (limitSeconds * 1000000);
+        int32_t id = world.startTask(routineTask, &run, vex::task::taskPriorityNormal);
+        while (!run.finished && world.currentMicros() < limit) {
+            world.sleep(10);
+        }
+
+        const RoutineProfiler &profiler = robot->getRoutineProfiler();
+        RoutineResult result;
+        result.routine = routine;
+        result.finished = run.finished;
+        result.seconds = run.finished ? profiler.routineMicros() / 1000000.0 : limitSeconds;
+        result.sleepSeconds = profiler.totalMicros("sleep") / 1000000.0;
+        result.settleSeconds = profiler.settleMicros() / 1000000.0;
+        result.idleSeconds = profiler.baseIdleMicros() / 1000000.0;
+        result.odometry = robot->getPose();
+        result.target = robot->getTargetPose();
+        result.pose = result.odometry;
+        if (!ideal) {
+            const ChassisState &chassis = simulation.getChassis();
+            result.pose.x = chassis.x;
+            result.pose.y = chassis.y;
+            result.pose.heading = chassis.heading;
+        }
+        for (int i = 0; i < profiler.recordCount(); i++) {
+            result.records.push_back(profiler.record(i));
+        }
+        result.loop = robot->getControlScheduler().statistics();
+
+        if (traceFile) {
+            FILE *file = fopen(traceFile, "w");
+            if (!file || !robot->getTrace().writeJson(writeTraceFile, file)) {
+                fprintf(stderr, "cannot write %s\n", traceFile);
+            }
+            if (file) {
+                fclose(file);
+            }
+        }
+
+        // the robot stops its own tasks in this world
+        world.stopTask(id);
+        world.shutdown();
+        delete robot;
+        setCurrentWorld(0);
+        return result;
+    }
+
+    DriverResult runDriver(double seconds, const std::vector<ControllerEvent> &script, const SimulationParameters &parameters, bool ideal) {
+        World &defaults = currentWorld();
+        World world;
+        world.installDevices(defaults);
+        RobotSimulation simulation(parameters);
+        if (!ideal) {
+            world.setPhysics(&simulation);
+        }
+        setCurrentWorld(&world);
+        uint64_t start = world.currentMicros();
+        for (size_t i = 0; i < script.size(); i++) {
+            ControllerEvent event = script[i];
+            event.micros += start;
+            world.addControllerEvent(event);
+        }
+
+        Robot *robot = new Robot();
+        robot->setLatencyMeasurement(true);
+        uint64_t limit = start + (uint64_t) (seconds * 1000000);
+        int32_t id = world.startTask(driverTask, robot, vex::task::taskPriorityNormal);
+        while (world.currentMicros() < limit) {
+            world.sleep(10);
+        }
+
+        const LatencyMeter &meter = robot->getLatencyMeter();
+        DriverResult result;
+        result.seconds = (world.currentMicros() - start) / 1000000.0;
+        for (int i = 0; i < LatencyMeter::maxChannels; i++) {
+            result.channelNames[i] = meter.channelName(i);
+            result.latency[i] = meter.statistics(i);
+        }
+        for (int i = 0; i < meter.sampleCount(); i++) {
+            LatencyMeter::Sample sample = meter.sample(i);
+            sample.inputMicros -= start;
+            sample.outputMicros -= start;
+            result.samples.push_back(sample);
+        }
+        result.droppedSamples = meter.droppedSamples();
+        result.handlerCalls = robot->getControllerInput().handlerCalls();
+        result.handlerSkips = robot->getControllerInput().handlerSkips();
+        result.loop = robot->getControlScheduler().statistics();
+
+        world.stopTask(id);
+        world.shutdown();
+        delete robot;
+        setCurrentWorld(0);
+        return result;
+    }
+
+    SimulationParameters randomize(unsigned int seed, int routine, int run, const Variation &variation) {
+        std::seed_seq sequence = {seed, (unsigned int) routine, (unsigned int) run};
+        std::mt19937 generator(sequence);
+        std::uniform_real_distribution<double> uniform(0, 1);
+        std::normal_distribution<double> normal(0, 1);
+
+        SimulationParameters parameters;
+        parameters.batteryVoltage = variation.batteryMinimum + (variation.batteryMaximum - variation.batteryMinimum) * uniform(generator);
+        parameters.wheelFriction = fmax(0.5, fmin(1.2, parameters.wheelFriction + variation.tractionSpread * normal(generator)));
+        parameters.slipVelocity = variation.slipMinimum + (variation.slipMaximum - variation.slipMinimum) * uniform(generator);
+        parameters.mass = parameters.mass + variation.massSpread * normal(generator);
+        parameters.startX = variation.placementSpread * normal(generator);
+        parameters.startY = variation.placementSpread * normal(generator);
+        parameters.startHeading = variation.headingSpread * normal(generator);
+        parameters.sonarNoise = variation.sonarNoiseMinimum + (variation.sonarNoiseMaximum - variation.sonarNoiseMinimum) * uniform(generator);
+        parameters.seed = generator();
+        return parameters;
+    }
+
+    double routineWindow(int routine) {
+        return routine == skillsRoutine ? 60 : 15;
+    }
+
+    double positionError(const Pose &a, const Pose &b) {
+        return sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+    }
+}
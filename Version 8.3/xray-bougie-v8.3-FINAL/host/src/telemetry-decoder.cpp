@@ -0,0 +1,318 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Telemetry decoder. Reads a telemetry file recorded by the robot (telemetry.bin on the SD card, see TelemetryRecorder) and prints
+*       match statistics: control loop period histogram, time in each primitive, peak motor temperatures and arm / ramp limit hits.
+*       Optionally writes every record as CSV
+* ------------------------------------------------------------------------
+*/
+
+#include "telemetry-recorder.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef TelemetryRecorder::Header Header;
+typedef TelemetryRecorder::Record Record;
+
+static const char *motorNames[SensorSnapshot::motorCount] = {
+    "baseTopLeft", "baseBottomLeft", "baseTopRight", "baseBottomRight", "leftIntake", "rightIntake", "rampLift", "armPivot"
+};
+static const char *sonarNames[SensorSnapshot::sonarCount] = {"rightSonar", "leftSonar", "backSonar"};
+
+/*
+* TelemetryFile struct. The file mapped into memory: the records are read where they lie in the mapping, nothing is copied.
+* Records are recordSize apart, which is larger than sizeof(Record) for files of later versions that added fields
+*/
+struct TelemetryFile {
+    const uint8_t *data;
+    size_t size;
+    const Header *header;
+    size_t recordCount;
+
+    const Record &record(size_t i) const {
+        return *reinterpret_cast<const Record *>(data + header->headerSize + i * header->recordSize);
+    };
+};
+
+/* ------------------------------------------------------------------------
+* Function: openTelemetry
+* Desc: maps a telemetry file into memory and checks its header
+* Param: path of the file, file to fill
+* Output: returns false and prints why if the file cannot be read
+*/
+static bool openTelemetry(const char *path, TelemetryFile &file) {
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || (size_t) info.st_size < sizeof(Header)) {
+        fprintf(stderr, "%s is not a telemetry file\n", path);
+        close(descriptor);
+        return false;
+    }
+    void *mapping = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "cannot map %s\n", path);
+        return false;
+    }
+    madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+
+    file.data = static_cast<const uint8_t *>(mapping);
+    file.size = info.st_size;
+    file.header = reinterpret_cast<const Header *>(file.data);
+    const Header &header = *file.header;
+    if (header.magic != TelemetryRecorder::magic) {
+        fprintf(stderr, "%s is not a telemetry file\n", path);
+        munmap(mapping, info.st_size);
+        return false;
+    }
+    if (header.version != TelemetryRecorder::version || header.headerSize < sizeof(Header) || header.recordSize < sizeof(Record) ||
+        header.motorCount != SensorSnapshot::motorCount || header.sonarCount != SensorSnapshot::sonarCount) {
+        fprintf(stderr, "%s has telemetry version %d, this decoder reads version %d\n", path, header.version, TelemetryRecorder::version);
+        munmap(mapping, info.st_size);
+        return false;
+    }
+    file.recordCount = file.size < header.headerSize ? 0 : (file.size - header.headerSize) / header.recordSize;
+    return true;
+}
+
+/* ------------------------------------------------------------------------
+* Function: writeCsv
+* Desc: writes one CSV line per record
+* Param: telemetry file, output stream
+* Output: none
+*/
+static void writeCsv(const TelemetryFile &file, FILE *out) {
+    fprintf(out, "seconds,primitive,arm_motion,ramp_motion,autonomous,dropped");
+    const char *quantities[] = {"position", "velocity", "current", "temperature"};
+    for (int q = 0; q < 4; q++) {
+        for (int m = 0; m < SensorSnapshot::motorCount; m++) {
+            fprintf(out, ",%s_%s", motorNames[m], quantities[q]);
+        }
+    }
+    for (int s = 0; s < SensorSnapshot::sonarCount; s++) {
+        fprintf(out, ",%s_mm", sonarNames[s]);
+    }
+    fprintf(out, ",axis1,axis2,axis3,axis4,buttons\n");
+
+    for (size_t i = 0; i < file.recordCount; i++) {
+        const Record &record = file.record(i);
+        fprintf(out, "%.6f,%s,%d,%d,%d,%u", record.micros / 1000000.0, TelemetryRecorder::primitiveName(record.primitive),
+                (record.flags & TelemetryRecorder::FLAG_ARM_MOTION) != 0, (record.flags & TelemetryRecorder::FLAG_RAMP_MOTION) != 0,
+                (record.flags & TelemetryRecorder::FLAG_AUTONOMOUS) != 0, record.dropped);
+        for (int m = 0; m < SensorSnapshot::motorCount; m++) {
+            fprintf(out, ",%.2f", record.position[m]);
+        }
+        for (int m = 0; m < SensorSnapshot::motorCount; m++) {
+            fprintf(out, ",%.2f", record.velocity[m]);
+        }
+        for (int m = 0; m < SensorSnapshot::motorCount; m++) {
+            fprintf(out, ",%.3f", record.current[m]);
+        }
+        for (int m = 0; m < SensorSnapshot::motorCount; m++) {
+            fprintf(out, ",%u", record.temperature[m]);
+        }
+        for (int s = 0; s < SensorSnapshot::sonarCount; s++) {
+            fprintf(out, ",%u", record.sonarMillimeters[s]);
+        }
+        fprintf(out, ",%d,%d,%d,%d,0x%03x\n", record.axis[0], record.axis[1], record.axis[2], record.axis[3], record.buttons);
+    }
+}
+
+/*
+* LimitHits struct. How often and how long a motor sat at one of its angle limits. A hit is a record at or past the limit that follows
+* one inside the limits
+*/
+struct LimitHits {
+    int lowerHits;
+    int upperHits;
+    double lowerSeconds;
+    double upperSeconds;
+    bool atLower;
+    bool atUpper;
+
+    void add(double position, double lower, double upper, double dt) {
+        bool lowerNow = position <= lower;
+        bool upperNow = position >= upper;
+        lowerHits += lowerNow && !atLower;
+        upperHits += upperNow && !atUpper;
+        lowerSeconds += lowerNow ? dt : 0;
+        upperSeconds += upperNow ? dt : 0;
+        atLower = lowerNow;
+        atUpper = upperNow;
+    };
+};
+
+/* ------------------------------------------------------------------------
+* Function: printSummary
+* Desc: prints the match statistics of a telemetry file
+* Param: telemetry file, output stream
+* Output: none
+*/
+static void printSummary(const TelemetryFile &file, FILE *out) {
+    const Header &header = *file.header;
+    double period = header.periodMicros / 1000000.0;
+    // ticks further apart than this are a pause between recorded periods (e.g. autonomous and driver control), not a slow tick
+    uint32_t pauseMicros = header.periodMicros * 10;
+
+    static const int histogramBins = 25; // one per millisecond, the last one counts everything longer
+    int histogram[histogramBins] = {0};
+    int pauses = 0;
+    uint32_t shortest = 0xffffffff;
+    uint32_t longest = 0;
+    uint64_t periodTotal = 0;
+    int periodCount = 0;
+
+    double primitiveSeconds[TelemetryRecorder::primitiveCount] = {0};
+    double armMotionSeconds = 0;
+    double rampMotionSeconds = 0;
+    double autonomousSeconds = 0;
+    double peakTemperature[SensorSnapshot::motorCount] = {0};
+    double peakCurrent[SensorSnapshot::motorCount] = {0};
+    LimitHits arm = LimitHits();
+    LimitHits ramp = LimitHits();
+
+    for (size_t i = 0; i < file.recordCount; i++) {
+        const Record &record = file.record(i);
+        // a record stands for the time until the next one, the last one for one period
+        double dt = period;
+        if (i + 1 < file.recordCount) {
+            uint32_t interval = file.record(i + 1).micros - record.micros;
+            if (interval > pauseMicros) {
+                pauses++;
+            } else {
+                dt = interval / 1000000.0;
+                int bin = interval / 1000;
+                histogram[bin < histogramBins ? bin : histogramBins - 1]++;
+                shortest = interval < shortest ? interval : shortest;
+                longest = interval > longest ? interval : longest;
+                periodTotal += interval;
+                periodCount++;
+            }
+        }
+
+        if (record.primitive < TelemetryRecorder::primitiveCount) {
+            primitiveSeconds[record.primitive] += dt;
+        }
+        armMotionSeconds += record.flags & TelemetryRecorder::FLAG_ARM_MOTION ? dt : 0;
+        rampMotionSeconds += record.flags & TelemetryRecorder::FLAG_RAMP_MOTION ? dt : 0;
+        autonomousSeconds += record.flags & TelemetryRecorder::FLAG_AUTONOMOUS ? dt : 0;
+        for (int m = 0; m < SensorSnapshot::motorCount; m++) {
+            peakTemperature[m] = record.temperature[m] > peakTemperature[m] ? record.temperature[m] : peakTemperature[m];
+            double current = record.current[m] < 0 ? -record.current[m] : record.current[m];
+            peakCurrent[m] = current > peakCurrent[m] ? current : peakCurrent[m];
+        }
+        arm.add(record.position[SensorSnapshot::ARM_PIVOT], header.armPivotLowerAngle, header.armPivotUpperAngle, dt);
+        ramp.add(record.position[SensorSnapshot::RAMP_LIFT], header.rampLiftLowerAngle, header.rampLiftUpperAngle, dt);
+    }
+
+    double seconds = file.recordCount == 0 ? 0 : file.record(file.recordCount - 1).micros / 1000000.0;
+    int dropped = file.recordCount == 0 ? 0 : file.record(file.recordCount - 1).dropped;
+    fprintf(out, "telemetry version %d, %zu records over %.2f s, %.0f ms period, %d dropped", header.version, file.recordCount, seconds,
+            period * 1000, dropped);
+    if (file.size > header.headerSize + file.recordCount * header.recordSize) {
+        fprintf(out, ", partial last record ignored");
+    }
+    fprintf(out, "\n\n");
+
+    fprintf(out, "loop period: %d ticks", periodCount);
+    if (periodCount > 0) {
+        fprintf(out, ", mean %.3f ms, min %.3f ms, max %.3f ms", periodTotal / 1000.0 / periodCount, shortest / 1000.0, longest / 1000.0);
+    }
+    fprintf(out, ", %d pauses between periods\n", pauses);
+    for (int bin = 0; bin < histogramBins; bin++) {
+        if (histogram[bin] == 0) {
+            continue;
+        }
+        int bar = (int) (50.0 * histogram[bin] / periodCount + 0.5);
+        char label[16];
+        snprintf(label, sizeof(label), bin < histogramBins - 1 ? "%2d - %2d ms" : ">= %2d ms", bin, bin + 1);
+        fprintf(out, "  %-10s %7d %6.2f%% %.*s\n", label, histogram[bin], 100.0 * histogram[bin] / periodCount, bar,
+                "##################################################");
+    }
+
+    fprintf(out, "\n%-16s %9s\n", "primitive", "time s");
+    for (int p = 0; p < TelemetryRecorder::primitiveCount; p++) {
+        if (primitiveSeconds[p] > 0) {
+            fprintf(out, "%-16s %9.2f\n", TelemetryRecorder::primitiveName(p), primitiveSeconds[p]);
+        }
+    }
+    fprintf(out, "%-16s %9.2f\n%-16s %9.2f\n%-16s %9.2f\n", "arm motion", armMotionSeconds, "ramp motion", rampMotionSeconds, "autonomous",
+            autonomousSeconds);
+
+    fprintf(out, "\n%-16s %9s %9s\n", "motor", "peak C", "peak A");
+    for (int m = 0; m < SensorSnapshot::motorCount; m++) {
+        fprintf(out, "%-16s %9.0f %9.2f\n", motorNames[m], peakTemperature[m], peakCurrent[m]);
+    }
+
+    fprintf(out, "\n%-16s %15s %15s %9s %9s %9s %9s\n", "limit", "lower deg", "upper deg", "lower", "lower s", "upper", "upper s");
+    fprintf(out, "%-16s %15.1f %15.1f %9d %9.2f %9d %9.2f\n", "armPivot", header.armPivotLowerAngle, header.armPivotUpperAngle, arm.lowerHits,
+            arm.lowerSeconds, arm.upperHits, arm.upperSeconds);
+    fprintf(out, "%-16s %15.1f %15.1f %9d %9.2f %9d %9.2f\n", "rampLift", header.rampLiftLowerAngle, header.rampLiftUpperAngle, ramp.lowerHits,
+            ramp.lowerSeconds, ramp.upperHits, ramp.upperSeconds);
+}
+
+static void usage(const char *program) {
+    printf("usage: %s [options] FILE\n", program);
+    printf("  FILE                   telemetry file recorded by the robot (telemetry.bin on the SD card)\n");
+    printf("  --csv FILE             also write every record as CSV to FILE, - for standard output (the statistics then go to standard error)\n");
+}
+
+int main(int argc, char **argv) {
+    const char *path = 0;
+    const char *csvPath = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (!path) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    TelemetryFile file;
+    if (!openTelemetry(path, file)) {
+        return 1;
+    }
+
+    FILE *summaryOut = stdout;
+    if (csvPath) {
+        bool toStdout = strcmp(csvPath, "-") == 0;
+        FILE *csv = toStdout ? stdout : fopen(csvPath, "w");
+        if (!csv) {
+            fprintf(stderr, "cannot write %s\n", csvPath);
+            return 1;
+        }
+        static char buffer[1 << 16];
+        setvbuf(csv, buffer, _IOFBF, sizeof(buffer));
+        writeCsv(file, csv);
+        if (toStdout) {
+            fflush(stdout);
+            summaryOut = stderr;
+        } else {
+            fclose(csv);
+        }
+    }
+    printSummary(file, summaryOut);
+
+    munmap(const_cast<uint8_t *>(file.data), file.size);
+    return 0;
+}
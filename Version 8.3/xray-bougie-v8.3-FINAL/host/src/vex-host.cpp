@@ -0,0 +1,871 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Host implementation of the vex:: stand-in and of the simulated world behind it
+* ------------------------------------------------------------------------
+*/
+
+#include "v5_vcs.h"
+#include "vex-host.h"
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <sys/stat.h>
+
+namespace vexhost {
+    static thread_local World *threadWorld = 0;
+
+    World &currentWorld() {
+        if (threadWorld) {
+            return *threadWorld;
+        }
+        static World defaultWorld;
+        return defaultWorld;
+    }
+
+    void setCurrentWorld(World *world) {
+        threadWorld = world;
+    }
+
+    double cartridgeRpm(int gearSetting) {
+        switch ((vex::gearSetting) gearSetting) {
+            case vex::gearSetting::ratio36_1:
+                return 100;
+            case vex::gearSetting::ratio6_1:
+                return 600;
+            default:
+                return 200;
+        }
+    }
+
+    double cartridgeTicks(double maxRpm) {
+        if (maxRpm <= 100) {
+            return 1800;
+        }
+        if (maxRpm >= 600) {
+            return 300;
+        }
+        return 900;
+    }
+
+    bool readControllerScript(const char *path, uint64_t offsetMicros, std::vector<ControllerEvent> &events) {
+        static const char *names[BUTTON_COUNT] = { "L1", "L2", "R1", "R2", "Up", "Down", "Left", "Right", "X", "B", "Y", "A" };
+
+        FILE *file = fopen(path, "r");
+        if (!file) {
+            return false;
+        }
+
+        char line[256];
+        while (fgets(line, sizeof(line), file)) {
+            if (line[0] == '#' || line[0] == '\n') {
+                continue;
+            }
+            double millis;
+            ControllerEvent event;
+            char buttons[128];
+            if (sscanf(line, "%lf %lf %lf %lf %lf %127s", &millis, &event.state.axis[0], &event.state.axis[1], &event.state.axis[2],
+                       &event.state.axis[3], buttons) != 6) {
+                continue;
+            }
+            event.micros = offsetMicros + (uint64_t) (millis * 1000);
+            for (int i = 0; i < BUTTON_COUNT; i++) {
+                event.state.buttons[i] = false;
+            }
+            for (char *name = strtok(buttons, "+"); name; name = strtok(0, "+")) {
+                for (int i = 0; i < BUTTON_COUNT; i++) {
+                    if (strcmp(name, names[i]) == 0) {
+                        event.state.buttons[i] = true;
+                    }
+                }
+            }
+            events.push_back(event);
+        }
+        fclose(file);
+        return true;
+    }
+
+    /* ------------------------------------------------------------------------
+    * IdealPhysics: every motor turns exactly at its commanded speed, stopped motors stand still
+    */
+    void IdealPhysics::step(World &world, double dt) {
+        for (int i = 0; i < motorPorts; i++) {
+            MotorState &motor = world.motors[i];
+            if (!motor.installed) {
+                continue;
+            }
+
+            double rpm = 0;
+            if (motor.mode == MOTOR_VELOCITY) {
+                rpm = fmax(-motor.maxRpm, fmin(motor.maxRpm, motor.command));
+            } else if (motor.mode == MOTOR_VOLTAGE) {
+                rpm = fmax(-12, fmin(12, motor.command)) / 12 * motor.maxRpm;
+            }
+
+            motor.velocity = rpm;
+            motor.position += rpm * 6 * dt;
+            motor.voltage = rpm / motor.maxRpm * 12;
+            motor.current = 0;
+            motor.torque = 0;
+        }
+    }
+
+    /* ------------------------------------------------------------------------
+    * World
+    */
+    World::World() {
+        physics = &idealPhysics;
+
+        for (int i = 0; i < motorPorts; i++) {
+            MotorState &motor = motors[i];
+            motor.installed = false;
+            motor.reversed = false;
+            motor.maxRpm = 200;
+            motor.mode = MOTOR_STOPPED;
+            motor.command = 0;
+            motor.stopping = STOP_COAST;
+            motor.defaultVelocity = 0;
+            motor.maxTorquePercent = 100;
+            motor.holdPosition = 0;
+            motor.position = 0;
+            motor.positionOffset = 0;
+            motor.velocity = 0;
+            motor.current = 0;
+            motor.voltage = 0;
+            motor.torque = 0;
+            motor.temperature = 25;
+        }
+        for (int i = 0; i < triportPorts; i++) {
+            sonarMillimeters[i] = 1000;
+        }
+        for (int i = 0; i < 4; i++) {
+            controller.axis[i] = 0;
+        }
+        for (int i = 0; i < BUTTON_COUNT; i++) {
+            controller.buttons[i] = false;
+        }
+    }
+
+    World::~World() {
+        shutdown();
+    }
+
+    void World::installDevices(const World &other) {
+        for (int i = 0; i < motorPorts; i++) {
+            const MotorState &source = other.motors[i];
+            MotorState &motor = motors[i];
+            motor.installed = source.installed;
+            motor.reversed = source.reversed;
+            motor.maxRpm = source.maxRpm;
+            motor.stopping = source.stopping;
+            motor.defaultVelocity = source.defaultVelocity;
+            motor.maxTorquePercent = source.maxTorquePercent;
+        }
+    }
+
+    // task record of the calling thread, created the first time a thread that is not a task of this world uses the scheduler
+    World::Task *World::attachThread() {
+        std::thread::id self = std::this_thread::get_id();
+        for (size_t i = 0; i < tasks.size(); i++) {
+            if (!tasks[i]->finished && tasks[i]->owner == self) {
+                return tasks[i];
+            }
+        }
+
+        Task *task = new Task();
+        task->id = (int32_t) tasks.size();
+        task->priority = vex::task::taskPriorityNormal;
+        task->wakeMicros = micros;
+        task->readySequence = ++readyCounter;
+        task->finished = false;
+        task->suspended = false;
+        task->function = 0;
+        task->argument = 0;
+        task->owner = self;
+        tasks.push_back(task);
+        if (!running) {
+            running = task;
+        }
+        return task;
+    }
+
+    World::Task *World::pickNext() {
+        Task *next = 0;
+        for (size_t i = 0; i < tasks.size(); i++) {
+            Task *task = tasks[i];
+            if (task->finished || task->suspended) {
+                continue;
+            }
+            if (!next || task->wakeMicros < next->wakeMicros ||
+                (task->wakeMicros == next->wakeMicros && (task->priority > next->priority ||
+                    (task->priority == next->priority && task->readySequence < next->readySequence)))) {
+                next = task;
+            }
+        }
+        return next;
+    }
+
+    void World::advanceTo(uint64_t target) {
+        while (micros < target) {
+            while (nextControllerEvent < controllerScript.size() && controllerScript[nextControllerEvent].micros <= micros) {
+                controller = controllerScript[nextControllerEvent].state;
+                nextControllerEvent++;
+            }
+            uint64_t step = target - micros;
+            if (step > stepMicros) {
+                step = stepMicros;
+            }
+            physics->step(*this, step / 1000000.0);
+            micros += step;
+        }
+        while (nextControllerEvent < controllerScript.size() && controllerScript[nextControllerEvent].micros <= micros) {
+            controller = controllerScript[nextControllerEvent].state;
+            nextControllerEvent++;
+        }
+    }
+
+    // give the turn to the next task, advancing the clock to its wake up time, and wait until the calling task has the turn again
+    void World::handOff(Task *self, std::unique_lock<std::mutex> &lock) {
+        if (shuttingDown || (self && self->finished)) {
+            throw SessionEnd();
+        }
+
+        Task *next = pickNext();
+        if (next && next->wakeMicros > micros) {
+            if (deadlineMicros > 0 && next->wakeMicros >= deadlineMicros) {
+                advanceTo(deadlineMicros);
+                next = 0;
+                shuttingDown = true;
+            } else {
+                advanceTo(next->wakeMicros);
+            }
+        }
+        running = next;
+        turnChanged.notify_all();
+        if (!self || shuttingDown) {
+            if (shuttingDown && self) {
+                throw SessionEnd();
+            }
+            return;
+        }
+
+        turnChanged.wait(lock, [&] { return running == self || shuttingDown || self->finished; });
+        if (shuttingDown || self->finished) {
+            throw SessionEnd();
+        }
+    }
+
+    void World::taskMain(World *world, Task *task) {
+        setCurrentWorld(world);
+        {
+            std::unique_lock<std::mutex> lock(world->mutex);
+            world->turnChanged.wait(lock, [&] { return world->running == task || world->shuttingDown || task->finished; });
+            if (world->shuttingDown || task->finished) {
+                task->finished = true;
+                return;
+            }
+        }
+
+        try {
+            task->function(task->argument);
+        } catch (SessionEnd &) {
+        }
+
+        std::unique_lock<std::mutex> lock(world->mutex);
+        task->finished = true;
+        if (world->running == task && !world->shuttingDown) {
+            try {
+                world->handOff(0, lock);
+            } catch (SessionEnd &) {
+            }
+        }
+    }
+
+    int32_t World::startTask(TaskFunction function, void *argument, int32_t priority) {
+        std::unique_lock<std::mutex> lock(mutex);
+        attachThread();
+
+        Task *task = new Task();
+        task->id = (int32_t) tasks.size();
+        task->priority = priority;
+        task->wakeMicros = micros;
+        task->readySequence = ++readyCounter;
+        task->finished = shuttingDown;
+        task->suspended = false;
+        task->function = function;
+        task->argument = argument;
+        tasks.push_back(task);
+        task->thread = std::thread(taskMain, this, task);
+        task->owner = task->thread.get_id();
+        return task->id;
+    }
+
+    void World::stopTask(int32_t id) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (id >= 0 && id < (int32_t) tasks.size()) {
+            tasks[id]->finished = true;
+            turnChanged.notify_all();
+        }
+    }
+
+    void World::suspendTask(int32_t id, bool suspend) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (id >= 0 && id < (int32_t) tasks.size()) {
+            tasks[id]->suspended = suspend;
+        }
+    }
+
+    void World::setTaskPriority(int32_t id, int32_t priority) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (id >= 0 && id < (int32_t) tasks.size()) {
+            tasks[id]->priority = priority;
+        }
+    }
+
+    int32_t World::taskPriority(int32_t id) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (id >= 0 && id < (int32_t) tasks.size()) {
+            return tasks[id]->priority;
+        }
+        return 0;
+    }
+
+    int32_t World::currentTask() {
+        std::unique_lock<std::mutex> lock(mutex);
+        return attachThread()->id;
+    }
+
+    void World::sleep(uint32_t millis) {
+        std::unique_lock<std::mutex> lock(mutex);
+        Task *self = attachThread();
+        self->wakeMicros = micros + (uint64_t) millis * 1000;
+        self->readySequence = ++readyCounter;
+        handOff(self, lock);
+    }
+
+    void World::shutdown() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            shuttingDown = true;
+            turnChanged.notify_all();
+        }
+        for (size_t i = 0; i < tasks.size(); i++) {
+            if (tasks[i]->thread.joinable() && tasks[i]->thread.get_id() != std::this_thread::get_id()) {
+                tasks[i]->thread.join();
+            }
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        for (size_t i = 0; i < tasks.size(); i++) {
+            if (tasks[i]->thread.joinable()) {
+                tasks[i]->thread.detach();
+            }
+            delete tasks[i];
+        }
+        tasks.clear();
+        running = 0;
+    }
+
+    bool World::isShuttingDown() {
+        std::unique_lock<std::mutex> lock(mutex);
+        return shuttingDown;
+    }
+
+    void World::addControllerEvent(const ControllerEvent &event) {
+        controllerScript.push_back(event);
+    }
+
+    bool World::loadControllerScript(const char *path, uint64_t offsetMicros) {
+        std::vector<ControllerEvent> events;
+        if (!readControllerScript(path, offsetMicros, events)) {
+            return false;
+        }
+        for (size_t i = 0; i < events.size(); i++) {
+            addControllerEvent(events[i]);
+        }
+        return true;
+    }
+
+    void World::screenPrint(const char *text) {
+        screenLine += text;
+    }
+
+    void World::screenNewLine() {
+        if (echoScreen) {
+            printf("[%9.3f] %s\n", micros / 1000000.0, screenLine.c_str());
+        }
+        screenLine.clear();
+        screenLines++;
+        screenRow++;
+    }
+}
+
+/* ------------------------------------------------------------------------
+* vex:: stand-in
+*/
+namespace vex {
+    using vexhost::currentWorld;
+    using vexhost::MotorState;
+
+    /*
+    * timer
+    */
+    timer::timer() {
+        startMicros = currentWorld().currentMicros();
+    }
+    double timer::time(timeUnits units) const {
+        double millis = (currentWorld().currentMicros() - startMicros) / 1000.0;
+        return units == timeUnits::sec ? millis / 1000 : millis;
+    }
+    void timer::clear() {
+        startMicros = currentWorld().currentMicros();
+    }
+    uint32_t timer::system() {
+        return (uint32_t) (currentWorld().currentMicros() / 1000);
+    }
+    uint64_t timer::systemHighResolution() {
+        return currentWorld().currentMicros();
+    }
+
+    /*
+    * motor
+    */
+    static MotorState &motorState(int32_t port) {
+        return currentWorld().motors[port];
+    }
+    // sign that turns a user direction into the motor's own direction
+    static double userSign(const MotorState &state) {
+        return state.reversed ? -1 : 1;
+    }
+    static double directionSign(directionType dir) {
+        return dir == directionType::rev ? -1 : 1;
+    }
+    static vexhost::StopMode toStopMode(brakeType mode) {
+        if (mode == brakeType::brake) {
+            return vexhost::STOP_BRAKE;
+        }
+        if (mode == brakeType::hold) {
+            return vexhost::STOP_HOLD;
+        }
+        return vexhost::STOP_COAST;
+    }
+    static double toRpm(const MotorState &state, double velocity, velocityUnits units) {
+        if (units == velocityUnits::pct) {
+            return velocity / 100 * state.maxRpm;
+        }
+        if (units == velocityUnits::dps) {
+            return velocity / 6;
+        }
+        return velocity;
+    }
+
+    motor::motor(int32_t index) : motor(index, gearSetting::ratio18_1, false) {
+    }
+    motor::motor(int32_t index, bool reverse) : motor(index, gearSetting::ratio18_1, reverse) {
+    }
+    motor::motor(int32_t index, gearSetting gears, bool reverse) {
+        port = index;
+        MotorState &state = motorState(port);
+        state.installed = true;
+        state.reversed = reverse;
+        state.maxRpm = vexhost::cartridgeRpm((int) gears);
+    }
+
+    void motor::spin(directionType dir) {
+        MotorState &state = motorState(port);
+        state.mode = vexhost::MOTOR_VELOCITY;
+        state.command = userSign(state) * directionSign(dir) * state.defaultVelocity;
+    }
+    void motor::spin(directionType dir, double velocity, velocityUnits units) {
+        MotorState &state = motorState(port);
+        state.mode = vexhost::MOTOR_VELOCITY;
+        state.command = userSign(state) * directionSign(dir) * toRpm(state, velocity, units);
+    }
+    void motor::spin(directionType dir, double velocity, percentUnits) {
+        spin(dir, velocity, velocityUnits::pct);
+    }
+    void motor::spin(directionType dir, double voltage, voltageUnits units) {
+        MotorState &state = motorState(port);
+        state.mode = vexhost::MOTOR_VOLTAGE;
+        state.command = userSign(state) * directionSign(dir) * (units == voltageUnits::mV ? voltage / 1000 : voltage);
+    }
+    void motor::stop() {
+        MotorState &state = motorState(port);
+        state.mode = vexhost::MOTOR_STOPPED;
+        state.command = 0;
+        state.holdPosition = state.position;
+    }
+    void motor::stop(brakeType mode) {
+        motorState(port).stopping = toStopMode(mode);
+        stop();
+    }
+
+    void motor::setVelocity(double velocity, velocityUnits units) {
+        MotorState &state = motorState(port);
+        state.defaultVelocity = toRpm(state, velocity, units);
+    }
+    void motor::setVelocity(double velocity, percentUnits) {
+        setVelocity(velocity, velocityUnits::pct);
+    }
+    void motor::setStopping(brakeType mode) {
+        motorState(port).stopping = toStopMode(mode);
+    }
+    void motor::setMaxTorque(double value, percentUnits) {
+        motorState(port).maxTorquePercent = fmax(0, fmin(100, value));
+    }
+    void motor::setMaxTorque(double value, currentUnits) {
+        motorState(port).maxTorquePercent = fmax(0, fmin(100, value / 2.5 * 100));
+    }
+    void motor::setReversed(bool value) {
+        motorState(port).reversed = value;
+    }
+    void motor::resetRotation() {
+        setRotation(0, rotationUnits::deg);
+    }
+    void motor::resetPosition() {
+        setRotation(0, rotationUnits::deg);
+    }
+    void motor::setRotation(double value, rotationUnits units) {
+        MotorState &state = motorState(port);
+        double degrees = value;
+        if (units == rotationUnits::rev) {
+            degrees = value * 360;
+        } else if (units == rotationUnits::raw) {
+            degrees = value / vexhost::cartridgeTicks(state.maxRpm) * 360;
+        }
+        state.positionOffset = userSign(state) * state.position - degrees;
+    }
+    void motor::setPosition(double value, rotationUnits units) {
+        setRotation(value, units);
+    }
+
+    double motor::rotation(rotationUnits units) {
+        MotorState &state = motorState(port);
+        double degrees = userSign(state) * state.position - state.positionOffset;
+        if (units == rotationUnits::rev) {
+            return degrees / 360;
+        }
+        if (units == rotationUnits::raw) {
+            return degrees / 360 * vexhost::cartridgeTicks(state.maxRpm);
+        }
+        return degrees;
+    }
+    double motor::position(rotationUnits units) {
+        return rotation(units);
+    }
+    double motor::velocity(velocityUnits units) {
+        MotorState &state = motorState(port);
+        double rpm = userSign(state) * state.velocity;
+        if (units == velocityUnits::pct) {
+            return rpm / state.maxRpm * 100;
+        }
+        if (units == velocityUnits::dps) {
+            return rpm * 6;
+        }
+        return rpm;
+    }
+    double motor::velocity(percentUnits) {
+        return velocity(velocityUnits::pct);
+    }
+    double motor::current(currentUnits) {
+        return fabs(motorState(port).current);
+    }
+    double motor::current(percentUnits) {
+        return fabs(motorState(port).current) / 2.5 * 100;
+    }
+    double motor::voltage(voltageUnits units) {
+        MotorState &state = motorState(port);
+        double volts = userSign(state) * state.voltage;
+        return units == voltageUnits::mV ? volts * 1000 : volts;
+    }
+    double motor::torque(torqueUnits units) {
+        double nm = fabs(motorState(port).torque);
+        return units == torqueUnits::InLb ? nm * 8.8507 : nm;
+    }
+    double motor::temperature(temperatureUnits units) {
+        double celsius = motorState(port).temperature;
+        return units == temperatureUnits::fahrenheit ? celsius * 9 / 5 + 32 : celsius;
+    }
+    double motor::temperature(percentUnits) {
+        return fmax(0, fmin(100, (motorState(port).temperature - 20) * 2));
+    }
+    bool motor::isSpinning() {
+        return fabs(motorState(port).velocity) > 0.5;
+    }
+    bool motor::installed() {
+        return motorState(port).installed;
+    }
+    int32_t motor::index() {
+        return port;
+    }
+
+    /*
+    * triport and sonar
+    */
+    triport::port::port(int32_t index) {
+        portIndex = index;
+    }
+    int32_t triport::port::index() const {
+        return portIndex;
+    }
+    triport::triport() : A(0), B(1), C(2), D(3), E(4), F(5), G(6), H(7) {
+    }
+
+    sonar::sonar(triport::port &port) {
+        portIndex = port.index();
+    }
+    double sonar::distance(distanceUnits units) {
+        double millimeters = currentWorld().sonarMillimeters[portIndex];
+        if (units == distanceUnits::in) {
+            return millimeters / 25.4;
+        }
+        if (units == distanceUnits::cm) {
+            return millimeters / 10;
+        }
+        return millimeters;
+    }
+    bool sonar::foundObject() {
+        return currentWorld().sonarMillimeters[portIndex] < 3000;
+    }
+
+    /*
+    * brain
+    */
+    void brain::lcd::print(const char *format, ...) {
+        char text[256];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        currentWorld().screenPrint(text);
+    }
+    void brain::lcd::print(int32_t value) {
+        print("%ld", (long) value);
+    }
+    void brain::lcd::print(double value) {
+        print("%.2f", value);
+    }
+    void brain::lcd::printAt(int32_t, int32_t, const char *format, ...) {
+        char text[256];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        currentWorld().screenPrint(text);
+        currentWorld().screenNewLine();
+    }
+    void brain::lcd::newLine() {
+        currentWorld().screenNewLine();
+    }
+    void brain::lcd::clearScreen() {
+        currentWorld().screenSetRow(1);
+    }
+    void brain::lcd::clearLine() {
+    }
+    void brain::lcd::clearLine(int32_t) {
+    }
+    void brain::lcd::setCursor(int32_t row, int32_t) {
+        currentWorld().screenSetRow(row);
+    }
+    int32_t brain::lcd::row() {
+        return currentWorld().getScreenRow();
+    }
+    int32_t brain::lcd::column() {
+        return 1;
+    }
+    void brain::lcd::drawRectangle(int32_t, int32_t, int32_t, int32_t, const char *) {
+    }
+    void brain::lcd::drawLine(int32_t, int32_t, int32_t, int32_t) {
+    }
+    bool brain::lcd::render() {
+        return true;
+    }
+    int32_t brain::lcd::xPosition() {
+        return 0;
+    }
+    int32_t brain::lcd::yPosition() {
+        return 0;
+    }
+    bool brain::lcd::pressing() {
+        return false;
+    }
+
+    static std::string sdPath(const char *name) {
+        return currentWorld().getSdCardDirectory() + "/" + name;
+    }
+    bool brain::sdcard::isInserted() {
+        struct stat info;
+        const std::string &directory = currentWorld().getSdCardDirectory();
+        return !directory.empty() && stat(directory.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+    }
+    int32_t brain::sdcard::loadfile(const char *name, uint8_t *buffer, int32_t len) {
+        if (!isInserted()) {
+            return 0;
+        }
+        FILE *file = fopen(sdPath(name).c_str(), "rb");
+        if (!file) {
+            return 0;
+        }
+        int32_t count = (int32_t) fread(buffer, 1, len, file);
+        fclose(file);
+        return count;
+    }
+    int32_t brain::sdcard::savefile(const char *name, uint8_t *buffer, int32_t len) {
+        if (!isInserted()) {
+            return 0;
+        }
+        FILE *file = fopen(sdPath(name).c_str(), "wb");
+        if (!file) {
+            return 0;
+        }
+        int32_t count = (int32_t) fwrite(buffer, 1, len, file);
+        fclose(file);
+        return count;
+    }
+    int32_t brain::sdcard::appendfile(const char *name, uint8_t *buffer, int32_t len) {
+        if (!isInserted()) {
+            return 0;
+        }
+        FILE *file = fopen(sdPath(name).c_str(), "ab");
+        if (!file) {
+            return 0;
+        }
+        int32_t count = (int32_t) fwrite(buffer, 1, len, file);
+        fclose(file);
+        return count;
+    }
+    int32_t brain::sdcard::size(const char *name) {
+        struct stat info;
+        if (!isInserted() || stat(sdPath(name).c_str(), &info) != 0) {
+            return 0;
+        }
+        return (int32_t) info.st_size;
+    }
+    bool brain::sdcard::exists(const char *name) {
+        struct stat info;
+        return isInserted() && stat(sdPath(name).c_str(), &info) == 0;
+    }
+
+    /*
+    * controller
+    */
+    controller::axis::axis(int32_t index) {
+        axisIndex = index;
+    }
+    int32_t controller::axis::value() const {
+        return (int32_t) lround(currentWorld().controller.axis[axisIndex] * 1.27);
+    }
+    int32_t controller::axis::position(percentUnits) const {
+        return (int32_t) lround(currentWorld().controller.axis[axisIndex]);
+    }
+
+    controller::button::button(int32_t index) {
+        buttonIndex = index;
+    }
+    bool controller::button::pressing() const {
+        return currentWorld().controller.buttons[buttonIndex];
+    }
+
+    controller::controller(controllerType) :
+        Axis1(0), Axis2(1), Axis3(2), Axis4(3),
+        ButtonL1(vexhost::BUTTON_L1), ButtonL2(vexhost::BUTTON_L2), ButtonR1(vexhost::BUTTON_R1), ButtonR2(vexhost::BUTTON_R2),
+        ButtonUp(vexhost::BUTTON_UP), ButtonDown(vexhost::BUTTON_DOWN), ButtonLeft(vexhost::BUTTON_LEFT), ButtonRight(vexhost::BUTTON_RIGHT),
+        ButtonX(vexhost::BUTTON_X), ButtonB(vexhost::BUTTON_B), ButtonY(vexhost::BUTTON_Y), ButtonA(vexhost::BUTTON_A) {
+    }
+
+    /*
+    * competition
+    */
+    competition::competition() {
+    }
+    void competition::autonomous(void (*callback)(void)) {
+        currentWorld().setAutonomousCallback(callback);
+    }
+    void competition::drivercontrol(void (*callback)(void)) {
+        currentWorld().setDriverCallback(callback);
+    }
+    bool competition::isAutonomous() {
+        return currentWorld().getCompetitionMode() == vexhost::MODE_AUTONOMOUS;
+    }
+    bool competition::isDriverControl() {
+        return currentWorld().getCompetitionMode() == vexhost::MODE_DRIVER;
+    }
+    bool competition::isEnabled() {
+        return currentWorld().getCompetitionMode() != vexhost::MODE_DISABLED;
+    }
+    bool competition::isCompetitionSwitch() {
+        return false;
+    }
+    bool competition::isFieldControl() {
+        return true;
+    }
+
+    /*
+    * task
+    */
+    static int callVoidTask(void *callback) {
+        return reinterpret_cast<int (*)(void)>(callback)();
+    }
+
+    task::task() {
+        taskId = -1;
+    }
+    task::task(int (*callback)(void)) : task(callback, taskPriorityNormal) {
+    }
+    task::task(int (*callback)(void), int32_t priority) {
+        taskId = currentWorld().startTask(callVoidTask, reinterpret_cast<void *>(callback), priority);
+    }
+    task::task(int (*callback)(void *), void *arg) : task(callback, arg, taskPriorityNormal) {
+    }
+    task::task(int (*callback)(void *), void *arg, int32_t priority) {
+        taskId = currentWorld().startTask(callback, arg, priority);
+    }
+
+    void task::stop() {
+        currentWorld().stopTask(taskId);
+    }
+    void task::suspend() {
+        currentWorld().suspendTask(taskId, true);
+    }
+    void task::resume() {
+        currentWorld().suspendTask(taskId, false);
+    }
+    int32_t task::priority() {
+        return currentWorld().taskPriority(taskId);
+    }
+    void task::setPriority(int32_t priority) {
+        currentWorld().setTaskPriority(taskId, priority);
+    }
+    int32_t task::index() {
+        return taskId;
+    }
+    void task::sleep(uint32_t time) {
+        currentWorld().sleep(time);
+    }
+    void task::yield() {
+        currentWorld().sleep(0);
+    }
+
+    namespace this_thread {
+        void sleep_for(uint32_t time) {
+            currentWorld().sleep(time);
+        }
+        void yield() {
+            currentWorld().sleep(0);
+        }
+        int32_t get_id() {
+            return currentWorld().currentTask();
+        }
+        int32_t priority() {
+            vexhost::World &world = currentWorld();
+            return world.taskPriority(world.currentTask());
+        }
+        void setPriority(int32_t priority) {
+            vexhost::World &world = currentWorld();
+            world.setTaskPriority(world.currentTask(), priority);
+        }
+    }
+}
@@ -0,0 +1,323 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Fixed-rate scheduler that paces every control loop of the robot
+* ------------------------------------------------------------------------
+*/
+
+#ifndef CONTROL_SCHEDULER_H
+#define CONTROL_SCHEDULER_H
+
+#include <math.h>
+#include <stdint.h>
+
+/*
+* ControlScheduler class. One instance is owned by the Robot and every control loop (motion primitives and the driver loop) waits on it
+* once per pass, so all loops run at the same fixed period instead of spinning as fast as the CPU allows.
+* Deadlines are absolute: time spent working inside a tick does not stretch the period. A loop that is still working when its deadline
+* passes is counted as an overrun and the schedule restarts from that moment instead of bursting to catch up.
+* Background jobs can be registered and are run once at the start of every tick.
+* Timing statistics are kept per control loop: a loop selects its statistics with setLoop() before it starts, so e.g. the autonomous
+* routine and the driver loop each keep their own period jitter, working time and overrun counts.
+* The clock and sleep functions are passed in so the same scheduler runs on the V5 brain and against a stand-in clock on a Linux host.
+*/
+class ControlScheduler {
+    public:
+        typedef uint64_t (*ClockFunction)(void); // current time in microseconds
+        typedef void (*SleepFunction)(uint32_t); // suspend the calling task for the given milliseconds
+        typedef void (*JobFunction)(void *context, double dt); // dt: seconds since the previous tick
+
+        static const int maxJobs = 8;
+        static const int maxLoops = 4;
+        static const int busyBins = 11; // tenths of the period, the last bin counts ticks that worked longer than a period
+
+        /*
+        * ticks: number of ticks run since the last reset
+        * overruns: ticks whose deadline had already passed when the loop asked to wait for it
+        * busyMicros: time spent working between ticks
+        * idleMicros: time spent sleeping until a deadline
+        * maxBusyMicros: longest time spent working between two ticks
+        * maxLatenessMicros: longest delay between a deadline and the tick actually starting
+        * minIntervalMicros / maxIntervalMicros: shortest and longest time between the starts of two ticks
+        * jitterMicros / jitterSquares: sum of the absolute and squared differences between the time between two ticks and the period
+        * maxJitterMicros: largest of those differences
+        * busyHistogram: ticks by the time the loop worked before waiting for the next one, in tenths of the period
+        */
+        struct Statistics {
+            uint32_t ticks;
+            uint32_t overruns;
+            uint64_t busyMicros;
+            uint64_t idleMicros;
+            uint64_t maxBusyMicros;
+            uint64_t maxLatenessMicros;
+            uint64_t minIntervalMicros;
+            uint64_t maxIntervalMicros;
+            uint64_t jitterMicros;
+            double jitterSquares;
+            uint64_t maxJitterMicros;
+            uint32_t busyHistogram[busyBins];
+
+            double meanBusyMicros() const {
+                return ticks == 0 ? 0 : (double) busyMicros / ticks;
+            };
+            double meanJitterMicros() const {
+                return ticks == 0 ? 0 : (double) jitterMicros / ticks;
+            };
+            double rmsJitterMicros() const {
+                return ticks == 0 ? 0 : sqrt(jitterSquares / ticks);
+            };
+            // smallest working time (microseconds) that the given fraction [0, 1] of the ticks stayed within, to a tenth of the period
+            double busyPercentileMicros(double fraction, uint64_t periodMicros) const {
+                uint32_t count = 0;
+                for (int bin = 0; bin < busyBins; bin++) {
+                    count += busyHistogram[bin];
+                    if (count >= fraction * ticks) {
+                        double bound = (bin + 1) * periodMicros / 10.0;
+                        return bin < busyBins - 1 && bound < maxBusyMicros ? bound : (double) maxBusyMicros;
+                    }
+                }
+                return (double) maxBusyMicros;
+            };
+        };
+
+    private:
+        struct Job {
+            JobFunction function;
+            void *context;
+        };
+
+        ClockFunction clock;
+        SleepFunction sleep;
+        uint64_t periodMicros;
+
+        bool started;
+        uint64_t deadline; // absolute time of the next tick (microseconds)
+        uint64_t lastTick; // time the current tick started (microseconds)
+        uint64_t previousTick; // time the previous tick started (microseconds)
+        uint64_t previousBusy; // time the previous tick spent working (microseconds)
+        double tickInterval; // seconds between the last two ticks
+
+        Job jobs[maxJobs];
+        Statistics loopStats[maxLoops];
+        const char *loopNames[maxLoops];
+        int loop; // loop whose statistics the ticks count in
+
+    public:
+        ControlScheduler(ClockFunction clockFunction, SleepFunction sleepFunction, uint32_t periodMillis = 10) {
+            clock = clockFunction;
+            sleep = sleepFunction;
+            periodMicros = (uint64_t) periodMillis * 1000;
+            started = false;
+            deadline = 0;
+            lastTick = 0;
+            previousTick = 0;
+            previousBusy = 0;
+            tickInterval = periodMillis / 1000.0;
+
+            for (int i = 0; i < maxJobs; i++) {
+                jobs[i].function = 0;
+                jobs[i].context = 0;
+            }
+            for (int i = 0; i < maxLoops; i++) {
+                loopNames[i] = 0;
+            }
+            loop = 0;
+            resetStatistics();
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: start
+        * Desc: (re)starts the schedule from the current time. Call before entering a control loop so that time spent outside the
+        *       scheduler (e.g. a plain task sleep between autonomous moves) is not counted as an overrun
+        * Param: none
+        * Output: next deadline is one period from now
+        */
+        void start() {
+            lastTick = clock();
+            deadline = lastTick + periodMicros;
+            started = true;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: waitForNextTick
+        * Desc: sleeps until the next deadline, then runs the registered jobs. Called once per pass at the end of every control loop
+        * Param: none
+        * Output: returns at the start of the next tick
+        */
+        void waitForNextTick() {
+            if (!started) {
+                start();
+            }
+
+            Statistics &stats = loopStats[loop];
+            uint64_t now = clock();
+            uint64_t busy = now - lastTick;
+            stats.busyMicros += busy;
+            if (busy > stats.maxBusyMicros) {
+                stats.maxBusyMicros = busy;
+            }
+
+            if (now >= deadline) {
+                // the loop missed its deadline; run this tick right away and restart the schedule from here
+                stats.overruns++;
+                deadline = now;
+            } else {
+                while (now < deadline) {
+                    sleep((uint32_t) ((deadline - now + 999) / 1000));
+                    now = clock();
+                }
+                stats.idleMicros += now - lastTick - busy;
+
+                uint64_t lateness = now - deadline;
+                if (lateness > stats.maxLatenessMicros) {
+                    stats.maxLatenessMicros = lateness;
+                }
+            }
+
+            uint64_t interval = now - lastTick;
+            uint64_t jitter = interval > periodMicros ? interval - periodMicros : periodMicros - interval;
+            stats.minIntervalMicros = interval < stats.minIntervalMicros ? interval : stats.minIntervalMicros;
+            stats.maxIntervalMicros = interval > stats.maxIntervalMicros ? interval : stats.maxIntervalMicros;
+            stats.jitterMicros += jitter;
+            stats.jitterSquares += (double) jitter * jitter;
+            stats.maxJitterMicros = jitter > stats.maxJitterMicros ? jitter : stats.maxJitterMicros;
+            int bin = (int) (busy * 10 / periodMicros);
+            stats.busyHistogram[bin < busyBins - 1 ? bin : busyBins - 1]++;
+
+            tickInterval = interval / 1000000.0;
+            previousTick = lastTick;
+            previousBusy = busy;
+            lastTick = now;
+            deadline = deadline + periodMicros;
+            stats.ticks++;
+
+            for (int i = 0; i < maxJobs; i++) {
+                if (jobs[i].function) {
+                    jobs[i].function(jobs[i].context, tickInterval);
+                }
+            }
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: sleepFor
+        * Desc: waits the given time while keeping the ticks (and therefore the registered jobs) running
+        * Param: milliseconds to wait
+        * Output: returns after at least the given time
+        */
+        void sleepFor(uint32_t millis) {
+            uint64_t end = clock() + (uint64_t) millis * 1000;
+            while (clock() < end) {
+                waitForNextTick();
+            }
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: addJob
+        * Desc: registers a function to run at the start of every tick. Jobs must not block or wait on the scheduler themselves
+        * Param: function to call, context pointer handed back to it
+        * Output: returns the job id used by removeJob, or -1 if all job slots are taken
+        */
+        int addJob(JobFunction function, void *context) {
+            for (int i = 0; i < maxJobs; i++) {
+                if (!jobs[i].function) {
+                    jobs[i].function = function;
+                    jobs[i].context = context;
+                    return i;
+                }
+            }
+            return -1;
+        };
+
+        void removeJob(int id) {
+            if (id >= 0 && id < maxJobs) {
+                jobs[id].function = 0;
+                jobs[id].context = 0;
+            }
+        };
+
+        /*
+        * SET functions
+        */
+        // names the control loop with the given id [0, maxLoops) for statistics pages
+        void setLoopName(int id, const char *name) {
+            if (id >= 0 && id < maxLoops) {
+                loopNames[id] = name;
+            }
+        };
+        // counts the following ticks in the statistics of the given loop. Call before start()
+        void setLoop(int id) {
+            if (id >= 0 && id < maxLoops) {
+                loop = id;
+            }
+        };
+
+        /*
+        * GET functions
+        */
+        double period() const {
+            return periodMicros / 1000000.0;
+        };
+        double lastTickInterval() const {
+            return tickInterval;
+        };
+        uint64_t currentMicros() const {
+            return clock();
+        };
+        // start of the current tick, and start and working time of the previous one (microseconds)
+        uint64_t tickMicros() const {
+            return lastTick;
+        };
+        uint64_t previousTickMicros() const {
+            return previousTick;
+        };
+        uint64_t previousBusyMicros() const {
+            return previousBusy;
+        };
+        uint64_t periodMicroseconds() const {
+            return periodMicros;
+        };
+        // statistics of the current loop, or of the loop with the given id
+        const Statistics &statistics() const {
+            return loopStats[loop];
+        };
+        const Statistics &statistics(int id) const {
+            return loopStats[id];
+        };
+        int currentLoop() const {
+            return loop;
+        };
+        const char *loopName(int id) const {
+            return loopNames[id];
+        };
+        // fraction of the time [0, 1] the current loop spent working rather than sleeping for a deadline
+        double cpuLoad() const {
+            const Statistics &stats = loopStats[loop];
+            uint64_t total = stats.busyMicros + stats.idleMicros;
+            return total == 0 ? 0 : (double) stats.busyMicros / total;
+        };
+
+        // clears the statistics of every loop
+        void resetStatistics() {
+            for (int i = 0; i < maxLoops; i++) {
+                Statistics &stats = loopStats[i];
+                stats.ticks = 0;
+                stats.overruns = 0;
+                stats.busyMicros = 0;
+                stats.idleMicros = 0;
+                stats.maxBusyMicros = 0;
+                stats.maxLatenessMicros = 0;
+                stats.minIntervalMicros = UINT64_MAX;
+                stats.maxIntervalMicros = 0;
+                stats.jitterMicros = 0;
+                stats.jitterSquares = 0;
+                stats.maxJitterMicros = 0;
+                for (int bin = 0; bin < busyBins; bin++) {
+                    stats.busyHistogram[bin] = 0;
+                }
+            }
+        };
+};
+
+#endif
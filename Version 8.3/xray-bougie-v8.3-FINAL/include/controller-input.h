@@ -0,0 +1,184 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Edge detection of the controller inputs and dispatch of the inputs that changed to the handler of each subsystem
+* ------------------------------------------------------------------------
+*/
+
+#ifndef CONTROLLER_INPUT_H
+#define CONTROLLER_INPUT_H
+
+#include <math.h>
+#include <stdint.h>
+
+#include "sensor-snapshot.h"
+
+/*
+* ControllerInput class. update() compares the controller inputs of a new sensor snapshot with the state it has cached and works out which
+* buttons were pressed and released and which axes moved; everything else reads the cached state (held(), axis()) instead of the devices.
+* Each subsystem registers a handler with the buttons and axes it reacts to, and dispatch() only calls the handlers whose inputs changed,
+* so a driver loop pass with no input change calls no handler and sends no motor command. A handler registered with whileHeld is also
+* called on every pass while one of its buttons is held, for subsystems that close a loop or watch a limit while the driver holds a button.
+* Handlers are called in registration order. invalidate() makes the next dispatch() call every handler, e.g. when the driver loop starts.
+*/
+class ControllerInput {
+    public:
+        typedef void (*HandlerFunction)(void *context, const ControllerInput &input);
+
+        static const int maxHandlers = 8;
+
+    private:
+        /*
+        * buttons / axes: bit (1 << Button) / (1 << Axis) of every input the handler reacts to
+        * whileHeld: also call the handler on every pass while one of its buttons is held
+        */
+        struct Handler {
+            uint16_t buttons;
+            uint8_t axes;
+            bool whileHeld;
+            HandlerFunction function;
+            void *context;
+        };
+
+        Handler handlers[maxHandlers];
+        int count;
+        double axisDeadband;
+        double axes[SensorSnapshot::axisCount];
+        uint16_t buttons;
+        uint16_t pressedButtons;
+        uint16_t releasedButtons;
+        uint8_t movedAxes;
+        bool invalid;
+        uint32_t calls;
+        uint32_t skipped;
+
+    public:
+        // axisDeadband: smallest axis movement that counts as a change (percent), so stick noise does not dispatch
+        ControllerInput(double myAxisDeadband) {
+            count = 0;
+            axisDeadband = myAxisDeadband;
+            for (int i = 0; i < SensorSnapshot::axisCount; i++) {
+                axes[i] = 0;
+            }
+            buttons = 0;
+            pressedButtons = 0;
+            releasedButtons = 0;
+            movedAxes = 0;
+            invalid = true;
+            calls = 0;
+            skipped = 0;
+        };
+
+        // bit of a button or an axis, for addHandler
+        static uint16_t buttonBit(SensorSnapshot::Button button) {
+            return 1 << button;
+        };
+        static uint8_t axisBit(SensorSnapshot::Axis axis) {
+            return 1 << axis;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: addHandler
+        * Desc: registers the handler of a subsystem
+        * Param: button and axis bits it reacts to, true to also call it every pass while one of its buttons is held, handler function,
+        *        context pointer handed to it
+        * Output: returns the handler's index, or -1 if there is no room left
+        */
+        int addHandler(uint16_t myButtons, uint8_t myAxes, bool whileHeld, HandlerFunction function, void *context) {
+            if (count >= maxHandlers) {
+                return -1;
+            }
+            Handler &handler = handlers[count];
+            handler.buttons = myButtons;
+            handler.axes = myAxes;
+            handler.whileHeld = whileHeld;
+            handler.function = function;
+            handler.context = context;
+            return count++;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: update
+        * Desc: takes the controller inputs of a new sensor snapshot. An axis only counts as moved, and its cached value only follows, once
+        *       it is axisDeadband away from the cached value or returns to exactly zero
+        * Param: sensor snapshot
+        * Output: updates the pressed, released and moved inputs and the cached state
+        */
+        void update(const SensorSnapshot &snapshot) {
+            pressedButtons = snapshot.buttons & ~buttons;
+            releasedButtons = buttons & ~snapshot.buttons;
+            buttons = snapshot.buttons;
+            movedAxes = 0;
+            for (int i = 0; i < SensorSnapshot::axisCount; i++) {
+                double value = snapshot.axis[i];
+                if (value != axes[i] && (fabs(value - axes[i]) >= axisDeadband || value == 0)) {
+                    axes[i] = value;
+                    movedAxes |= 1 << i;
+                }
+            }
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: dispatch
+        * Desc: calls the handlers whose buttons or axes changed in the last update, and those registered whileHeld with a button held
+        * Param: none
+        * Output: returns the number of handlers called
+        */
+        int dispatch() {
+            uint16_t changed = pressedButtons | releasedButtons;
+            int called = 0;
+            for (int i = 0; i < count; i++) {
+                const Handler &handler = handlers[i];
+                if (invalid || (handler.buttons & changed) || (handler.axes & movedAxes) || (handler.whileHeld && (handler.buttons & buttons))) {
+                    handler.function(handler.context, *this);
+                    called++;
+                } else {
+                    skipped++;
+                }
+            }
+            invalid = false;
+            calls += called;
+            return called;
+        };
+
+        // makes the next dispatch call every handler
+        void invalidate() {
+            invalid = true;
+        };
+
+        /*
+        * GET functions
+        */
+        // button went down / up in the last update, or is down
+        bool pressed(SensorSnapshot::Button button) const {
+            return (pressedButtons >> button) & 1;
+        };
+        bool released(SensorSnapshot::Button button) const {
+            return (releasedButtons >> button) & 1;
+        };
+        bool held(SensorSnapshot::Button button) const {
+            return (buttons >> button) & 1;
+        };
+        // cached axis position (percent)
+        double axis(SensorSnapshot::Axis axis) const {
+            return axes[axis];
+        };
+        // bits of the buttons that were pressed or released and of the axes that moved in the last update
+        uint16_t changedButtons() const {
+            return pressedButtons | releasedButtons;
+        };
+        uint8_t changedAxes() const {
+            return movedAxes;
+        };
+        // handler calls made and handler calls skipped because none of their inputs changed
+        uint32_t handlerCalls() const {
+            return calls;
+        };
+        uint32_t handlerSkips() const {
+            return skipped;
+        };
+};
+
+#endif
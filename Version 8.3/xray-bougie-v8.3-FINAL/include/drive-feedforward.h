@@ -0,0 +1,211 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Feedforward model of the drive motors and the least squares fit that characterizes it
+* ------------------------------------------------------------------------
+*/
+
+#ifndef DRIVE_FEEDFORWARD_H
+#define DRIVE_FEEDFORWARD_H
+
+#include <math.h>
+#include <stdint.h>
+
+/*
+* DriveFeedforward class. Motor voltage (percent of full voltage) one side of the base needs to move its wheels at a given speed and acceleration:
+*   percent = kS * sign(velocity) + kV * velocity + kA * acceleration
+* kS overcomes static friction, kV holds a speed against back EMF and friction, kA accelerates the robot.
+* Velocity in meters / second of wheel surface speed, acceleration in meters / second^2.
+*/
+class DriveFeedforward {
+    public:
+        /*
+        * Gains as stored on the SD card. magic marks a valid file, version changes whenever the layout does
+        */
+        struct Gains {
+            uint32_t magic;
+            uint32_t version;
+            double kS;
+            double kV;
+            double kA;
+        };
+
+        static const uint32_t fileMagic = 0x46464458; // "XDFF"
+        static const uint32_t fileVersion = 1;
+
+    private:
+        double kS;
+        double kV;
+        double kA;
+
+    public:
+        DriveFeedforward(double myKS, double myKV, double myKA) {
+            kS = myKS;
+            kV = myKV;
+            kA = myKA;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: calculate
+        * Desc: voltage needed for a velocity and acceleration setpoint
+        * Param: velocity (meters / second), acceleration (meters / second^2)
+        * Output: returns percent of full motor voltage, not clamped
+        */
+        double calculate(double velocity, double acceleration) const {
+            double direction = 0;
+            if (velocity > 0) {
+                direction = 1;
+            } else if (velocity < 0) {
+                direction = -1;
+            }
+            return kS * direction + kV * velocity + kA * acceleration;
+        };
+
+        Gains toGains() const {
+            Gains gains;
+            gains.magic = fileMagic;
+            gains.version = fileVersion;
+            gains.kS = kS;
+            gains.kV = kV;
+            gains.kA = kA;
+            return gains;
+        };
+        // takes the gains if they are a valid stored set, returns false (and keeps the current gains) otherwise
+        bool fromGains(const Gains &gains) {
+            if (gains.magic != fileMagic || gains.version != fileVersion || gains.kV <= 0) {
+                return false;
+            }
+            kS = gains.kS;
+            kV = gains.kV;
+            kA = gains.kA;
+            return true;
+        };
+
+        /*
+        * GET functions
+        */
+        double getKS() const {
+            return kS;
+        };
+        double getKV() const {
+            return kV;
+        };
+        double getKA() const {
+            return kA;
+        };
+};
+
+/*
+* FeedforwardFitter class. Collects (voltage, velocity, acceleration) samples from the characterization tests and fits kS, kV and kA by
+* ordinary least squares. Only the sums of the normal equations are kept, so any number of samples fits in a fixed amount of memory.
+* Samples where the base has not started moving are skipped since static friction there does not follow the model.
+*/
+class FeedforwardFitter {
+    private:
+        double xtx[3][3];
+        double xty[3];
+        int samples;
+        double minimumVelocity; // meters / second
+
+    public:
+        FeedforwardFitter(double myMinimumVelocity = 0.02) {
+            minimumVelocity = myMinimumVelocity;
+            reset();
+        };
+
+        void reset() {
+            for (int i = 0; i < 3; i++) {
+                xty[i] = 0;
+                for (int j = 0; j < 3; j++) {
+                    xtx[i][j] = 0;
+                }
+            }
+            samples = 0;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: addSample
+        * Desc: records one control tick of a characterization test
+        * Param:
+        *   - voltage applied (percent of full voltage)
+        *   - measured velocity (meters / second)
+        *   - measured acceleration (meters / second^2)
+        * Output: none
+        */
+        void addSample(double voltage, double velocity, double acceleration) {
+            if (fabs(velocity) < minimumVelocity) {
+                return;
+            }
+            double x[3] = { velocity > 0 ? 1.0 : -1.0, velocity, acceleration };
+            for (int i = 0; i < 3; i++) {
+                xty[i] += x[i] * voltage;
+                for (int j = 0; j < 3; j++) {
+                    xtx[i][j] += x[i] * x[j];
+                }
+            }
+            samples++;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: fit
+        * Desc: solves the normal equations by Gaussian elimination with partial pivoting
+        * Param: model to store the fitted gains in
+        * Output: returns false (and leaves the model alone) if there are too few samples or the tests did not excite every term
+        */
+        bool fit(DriveFeedforward &model) const {
+            if (samples < 3) {
+                return false;
+            }
+
+            double a[3][4];
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    a[i][j] = xtx[i][j];
+                }
+                a[i][3] = xty[i];
+            }
+
+            for (int column = 0; column < 3; column++) {
+                int pivot = column;
+                for (int row = column + 1; row < 3; row++) {
+                    if (fabs(a[row][column]) > fabs(a[pivot][column])) {
+                        pivot = row;
+                    }
+                }
+                if (fabs(a[pivot][column]) < 1e-9) {
+                    return false;
+                }
+                for (int j = 0; j < 4; j++) {
+                    double swap = a[column][j];
+                    a[column][j] = a[pivot][j];
+                    a[pivot][j] = swap;
+                }
+                for (int row = column + 1; row < 3; row++) {
+                    double factor = a[row][column] / a[column][column];
+                    for (int j = column; j < 4; j++) {
+                        a[row][j] -= factor * a[column][j];
+                    }
+                }
+            }
+
+            double gains[3];
+            for (int row = 2; row >= 0; row--) {
+                double sum = a[row][3];
+                for (int j = row + 1; j < 3; j++) {
+                    sum -= a[row][j] * gains[j];
+                }
+                gains[row] = sum / a[row][row];
+            }
+
+            DriveFeedforward fitted = DriveFeedforward(gains[0], gains[1], gains[2]);
+            return model.fromGains(fitted.toGains());
+        };
+
+        int sampleCount() const {
+            return samples;
+        };
+};
+
+#endif
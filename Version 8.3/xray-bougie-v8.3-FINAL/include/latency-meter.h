@@ -0,0 +1,188 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Measures the time from a change of the controller inputs to the motor command it causes, per subsystem
+* ------------------------------------------------------------------------
+*/
+
+#ifndef LATENCY_METER_H
+#define LATENCY_METER_H
+
+#include <stdint.h>
+
+/*
+* LatencyMeter class. Each channel stands for a subsystem (base, intake, ...) and the controller inputs that drive it. The driver loop
+* calls inputChanged() with the time of the sensor snapshot in which one of those inputs changed, and commanded() right after it has sent
+* the subsystem's motor commands for that snapshot; the time in between goes into the channel's statistics and the sample list.
+* A change that arrives while an earlier one is still waiting for its command keeps the earlier time, so a burst of changes counts once,
+* from its first change. commanded() only reads the clock when a change is waiting, so the meter costs next to nothing while the inputs
+* stay put. Samples go into a fixed array that is only cleared by start(); once it is full, the statistics still count every sample.
+*/
+class LatencyMeter {
+    public:
+        typedef uint64_t (*ClockFunction)(void); // current time in microseconds
+
+        static const int maxChannels = 4;
+        static const int maxSamples = 2048;
+        static const uint32_t binMicros = 100;
+        static const int latencyBins = 101; // tenths of a millisecond, the last bin counts latencies of 10 ms and more
+
+        /*
+        * channel: subsystem the inputs drive, inputMicros: time of the snapshot the change showed up in, outputMicros: time the command was sent
+        */
+        struct Sample {
+            uint64_t inputMicros;
+            uint64_t outputMicros;
+            int channel;
+        };
+
+        /*
+        * count: changes that got their command since start(), totalMicros / minMicros / maxMicros: sum, shortest and longest latency
+        * histogram: changes by latency, in bins of binMicros
+        */
+        struct Statistics {
+            uint32_t count;
+            uint64_t totalMicros;
+            uint64_t minMicros;
+            uint64_t maxMicros;
+            uint32_t histogram[latencyBins];
+
+            double meanMicros() const {
+                return count == 0 ? 0 : (double) totalMicros / count;
+            };
+            // smallest latency (microseconds) that the given fraction [0, 1] of the changes stayed within, to a bin
+            double percentileMicros(double fraction) const {
+                uint32_t total = 0;
+                for (int bin = 0; bin < latencyBins; bin++) {
+                    total += histogram[bin];
+                    if (total >= fraction * count) {
+                        double bound = (bin + 1) * (double) binMicros;
+                        return bin < latencyBins - 1 && bound < maxMicros ? bound : (double) maxMicros;
+                    }
+                }
+                return (double) maxMicros;
+            };
+        };
+
+    private:
+        ClockFunction clock;
+        const char *channelNames[maxChannels];
+        bool pending[maxChannels];
+        uint64_t pendingMicros[maxChannels];
+        Statistics channelStats[maxChannels];
+        Sample samples[maxSamples];
+        int count;
+        uint32_t dropped;
+        bool measuring;
+
+        // clears the statistics, the samples and the waiting changes
+        void clear() {
+            for (int i = 0; i < maxChannels; i++) {
+                pending[i] = false;
+                pendingMicros[i] = 0;
+                Statistics &stats = channelStats[i];
+                stats.count = 0;
+                stats.totalMicros = 0;
+                stats.minMicros = UINT64_MAX;
+                stats.maxMicros = 0;
+                for (int bin = 0; bin < latencyBins; bin++) {
+                    stats.histogram[bin] = 0;
+                }
+            }
+            count = 0;
+            dropped = 0;
+        };
+
+    public:
+        LatencyMeter(ClockFunction clockFunction) {
+            clock = clockFunction;
+            for (int i = 0; i < maxChannels; i++) {
+                channelNames[i] = 0;
+            }
+            clear();
+            measuring = false;
+        };
+
+        void setChannelName(int channel, const char *name) {
+            if (channel >= 0 && channel < maxChannels) {
+                channelNames[channel] = name;
+            }
+        };
+
+        // clears the statistics and samples and starts measuring
+        void start() {
+            clear();
+            measuring = true;
+        };
+
+        void stop() {
+            measuring = false;
+        };
+
+        // an input of the channel changed in the sensor snapshot taken at inputMicros
+        void inputChanged(int channel, uint64_t inputMicros) {
+            if (measuring && channel >= 0 && channel < maxChannels && !pending[channel]) {
+                pending[channel] = true;
+                pendingMicros[channel] = inputMicros;
+            }
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: commanded
+        * Desc: the motor commands of the channel were just sent. Records the latency of the change waiting for them, if there is one
+        * Param: channel
+        * Output: updates the channel's statistics and the sample list
+        */
+        void commanded(int channel) {
+            if (channel < 0 || channel >= maxChannels || !pending[channel]) {
+                return;
+            }
+            uint64_t now = clock();
+            uint64_t latency = now > pendingMicros[channel] ? now - pendingMicros[channel] : 0;
+            pending[channel] = false;
+
+            Statistics &stats = channelStats[channel];
+            stats.count++;
+            stats.totalMicros += latency;
+            stats.minMicros = latency < stats.minMicros ? latency : stats.minMicros;
+            stats.maxMicros = latency > stats.maxMicros ? latency : stats.maxMicros;
+            int bin = (int) (latency / binMicros);
+            stats.histogram[bin < latencyBins ? bin : latencyBins - 1]++;
+
+            if (count >= maxSamples) {
+                dropped++;
+                return;
+            }
+            Sample &sample = samples[count++];
+            sample.inputMicros = pendingMicros[channel];
+            sample.outputMicros = now;
+            sample.channel = channel;
+        };
+
+        /*
+        * GET functions
+        */
+        bool isMeasuring() const {
+            return measuring;
+        };
+        const char *channelName(int channel) const {
+            return channel >= 0 && channel < maxChannels ? channelNames[channel] : 0;
+        };
+        const Statistics &statistics(int channel) const {
+            return channelStats[channel];
+        };
+        int sampleCount() const {
+            return count;
+        };
+        const Sample &sample(int index) const {
+            return samples[index];
+        };
+        // samples that did not fit into the sample list (they are in the statistics)
+        uint32_t droppedSamples() const {
+            return dropped;
+        };
+};
+
+#endif
@@ -0,0 +1,82 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Completion handles for motions that run in the background on the control scheduler
+* ------------------------------------------------------------------------
+*/
+
+#ifndef MOTION_HANDLE_H
+#define MOTION_HANDLE_H
+
+#include "control-scheduler.h"
+
+/*
+* MotionChannel class. One instance per subsystem (base, arm, ramp) that can run a background motion.
+* Every motion started on the channel gets the next sequence number; the channel remembers the sequence number of the last
+* motion that finished. Only one motion runs on a channel at a time, so a motion is done once the finished count has reached it.
+*/
+class MotionChannel {
+    private:
+        unsigned int started = 0;
+        unsigned int finished = 0;
+
+    public:
+        // claim the next sequence number for a motion that is starting on this channel
+        unsigned int begin() {
+            return ++started;
+        };
+        // mark the running motion as finished
+        void finish() {
+            finished = started;
+        };
+        bool isBusy() const {
+            return finished != started;
+        };
+        bool isDone(unsigned int sequence) const {
+            return (int) (finished - sequence) >= 0;
+        };
+};
+
+/*
+* MotionHandle class. Returned by every asynchronous motion primitive. The motion itself advances on the control scheduler ticks,
+* so it keeps running while the caller starts other motions, sleeps with ControlScheduler::sleepFor or awaits another handle.
+*/
+class MotionHandle {
+    private:
+        ControlScheduler *scheduler;
+        const MotionChannel *channel;
+        unsigned int sequence;
+
+    public:
+        MotionHandle(ControlScheduler *myScheduler, const MotionChannel *myChannel, unsigned int mySequence) {
+            scheduler = myScheduler;
+            channel = myChannel;
+            sequence = mySequence;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: isDone
+        * Desc: polls the motion without waiting
+        * Param: none
+        * Output: true once the motion has finished
+        */
+        bool isDone() const {
+            return channel->isDone(sequence);
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: await
+        * Desc: keeps the control scheduler ticking until the motion has finished
+        * Param: none
+        * Output: returns once the motion has finished
+        */
+        void await() const {
+            while (!isDone()) {
+                scheduler->waitForNextTick();
+            }
+        };
+};
+
+#endif
@@ -0,0 +1,267 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Time parameterized motion profiles that give each control tick a position and velocity setpoint
+* ------------------------------------------------------------------------
+*/
+
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+#include <math.h>
+
+/*
+* Setpoint of a profile at one point in time. Same units as the profile (e.g. meters, m/s, m/s^2)
+*/
+struct ProfileState {
+    double position;
+    double velocity;
+    double acceleration;
+};
+
+/*
+* TrapezoidalProfile class. Moves a given (signed) distance starting and ending at rest: accelerates at maxAcceleration,
+* cruises at maxVelocity, then decelerates at maxAcceleration. Moves that are too short to reach maxVelocity
+* become a triangle that peaks below it.
+* The profile only computes its phase durations when created; sample() is a handful of multiplications and can run every tick.
+*/
+class TrapezoidalProfile {
+    private:
+        double distance = 0;
+        double direction = 1;
+        double maxAcceleration = 0;
+        double peakVelocity = 0; // highest speed actually reached, always positive
+        double accelerationTime = 0;
+        double cruiseTime = 0;
+
+    public:
+        TrapezoidalProfile() {};
+
+        /*
+        * - distance to travel, negative for backwards
+        * - maximum speed (positive)
+        * - maximum acceleration and deceleration (positive)
+        */
+        TrapezoidalProfile(double myDistance, double myMaxVelocity, double myMaxAcceleration) {
+            distance = myDistance;
+            direction = (myDistance >= 0) ? 1 : -1;
+            maxAcceleration = myMaxAcceleration;
+
+            double length = fabs(myDistance);
+            if (length == 0 || myMaxVelocity <= 0 || myMaxAcceleration <= 0) {
+                return;
+            }
+
+            // distance needed to reach full speed and stop again; if the move is shorter the profile is a triangle
+            if (myMaxVelocity * myMaxVelocity / myMaxAcceleration <= length) {
+                peakVelocity = myMaxVelocity;
+                accelerationTime = myMaxVelocity / myMaxAcceleration;
+                cruiseTime = (length - myMaxVelocity * accelerationTime) / myMaxVelocity;
+            } else {
+                peakVelocity = sqrt(length * myMaxAcceleration);
+                accelerationTime = peakVelocity / myMaxAcceleration;
+                cruiseTime = 0;
+            }
+        };
+
+        // total time of the profile (seconds)
+        double duration() const {
+            return 2 * accelerationTime + cruiseTime;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: sample
+        * Desc: setpoint at a given time since the start of the profile
+        * Param: seconds since the start of the profile
+        * Output: position, velocity and acceleration the mechanism should have at that time. Clamped to the end of the profile
+        */
+        ProfileState sample(double time) const {
+            ProfileState state;
+            double decelerationStart = accelerationTime + cruiseTime;
+
+            if (time <= 0) {
+                state.position = 0;
+                state.velocity = 0;
+                state.acceleration = 0;
+            } else if (time < accelerationTime) {
+                state.position = 0.5 * maxAcceleration * time * time;
+                state.velocity = maxAcceleration * time;
+                state.acceleration = maxAcceleration;
+            } else if (time < decelerationStart) {
+                state.position = 0.5 * peakVelocity * accelerationTime + peakVelocity * (time - accelerationTime);
+                state.velocity = peakVelocity;
+                state.acceleration = 0;
+            } else if (time < duration()) {
+                double remaining = duration() - time;
+                state.position = fabs(distance) - 0.5 * maxAcceleration * remaining * remaining;
+                state.velocity = maxAcceleration * remaining;
+                state.acceleration = -maxAcceleration;
+            } else {
+                state.position = fabs(distance);
+                state.velocity = 0;
+                state.acceleration = 0;
+            }
+
+            state.position *= direction;
+            state.velocity *= direction;
+            state.acceleration *= direction;
+            return state;
+        };
+
+        bool isFinished(double time) const {
+            return time >= duration();
+        };
+        double getDistance() const {
+            return distance;
+        };
+};
+
+/*
+* SCurveProfile class. Jerk limited version of TrapezoidalProfile: the acceleration itself ramps up and down at maxJerk, so the mechanism
+* never sees a step in acceleration when it starts, reaches cruise speed or stops. Used for the arm pivot and the ramp lift, where an
+* abrupt start or stop shakes the cubes.
+* Each acceleration phase has up to three parts (jerk up, constant acceleration, jerk down); the deceleration phase mirrors it.
+* Moves too short to reach maxVelocity peak at the highest velocity that still fits, found by bisection when the profile is created.
+*/
+class SCurveProfile {
+    private:
+        double distance = 0;
+        double direction = 1;
+        double maxJerk = 0;
+        double peakVelocity = 0; // highest speed actually reached, always positive
+        double jerkTime = 0; // duration of each jerk part of an acceleration phase
+        double accelerationTime = 0; // duration of a whole acceleration phase
+        double cruiseTime = 0;
+
+        // acceleration phase timing needed to reach a given velocity from rest
+        static void accelerationTiming(double velocity, double myMaxAcceleration, double myMaxJerk, double &myJerkTime, double &myAccelerationTime) {
+            if (velocity * myMaxJerk >= myMaxAcceleration * myMaxAcceleration) {
+                myJerkTime = myMaxAcceleration / myMaxJerk;
+                myAccelerationTime = velocity / myMaxAcceleration + myJerkTime;
+            } else {
+                myJerkTime = sqrt(velocity / myMaxJerk);
+                myAccelerationTime = 2 * myJerkTime;
+            }
+        };
+
+        // state during the acceleration phase, time measured from the start of the phase
+        ProfileState accelerationState(double time) const {
+            ProfileState state;
+            double peakAcceleration = maxJerk * jerkTime;
+            double constantTime = accelerationTime - 2 * jerkTime;
+            double jerkVelocity = 0.5 * maxJerk * jerkTime * jerkTime;
+            double jerkPosition = maxJerk * jerkTime * jerkTime * jerkTime / 6;
+
+            if (time < jerkTime) {
+                state.acceleration = maxJerk * time;
+                state.velocity = 0.5 * maxJerk * time * time;
+                state.position = maxJerk * time * time * time / 6;
+            } else if (time < jerkTime + constantTime) {
+                double t = time - jerkTime;
+                state.acceleration = peakAcceleration;
+                state.velocity = jerkVelocity + peakAcceleration * t;
+                state.position = jerkPosition + jerkVelocity * t + 0.5 * peakAcceleration * t * t;
+            } else {
+                double t = fmin(time, accelerationTime) - jerkTime - constantTime;
+                double startVelocity = jerkVelocity + peakAcceleration * constantTime;
+                double startPosition = jerkPosition + jerkVelocity * constantTime + 0.5 * peakAcceleration * constantTime * constantTime;
+                state.acceleration = peakAcceleration - maxJerk * t;
+                state.velocity = startVelocity + peakAcceleration * t - 0.5 * maxJerk * t * t;
+                state.position = startPosition + startVelocity * t + 0.5 * peakAcceleration * t * t - maxJerk * t * t * t / 6;
+            }
+            return state;
+        };
+
+    public:
+        SCurveProfile() {};
+
+        /*
+        * - distance to travel, negative for backwards
+        * - maximum speed (positive)
+        * - maximum acceleration and deceleration (positive)
+        * - maximum jerk (positive)
+        */
+        SCurveProfile(double myDistance, double myMaxVelocity, double myMaxAcceleration, double myMaxJerk) {
+            distance = myDistance;
+            direction = (myDistance >= 0) ? 1 : -1;
+            maxJerk = myMaxJerk;
+
+            double length = fabs(myDistance);
+            if (length == 0 || myMaxVelocity <= 0 || myMaxAcceleration <= 0 || myMaxJerk <= 0) {
+                return;
+            }
+
+            // an acceleration phase from rest to v covers v * accelerationTime / 2, and the deceleration phase the same again
+            peakVelocity = myMaxVelocity;
+            accelerationTiming(peakVelocity, myMaxAcceleration, myMaxJerk, jerkTime, accelerationTime);
+            if (peakVelocity * accelerationTime > length) {
+                double low = 0;
+                double high = myMaxVelocity;
+                for (int i = 0; i < 50; i++) {
+                    peakVelocity = 0.5 * (low + high);
+                    accelerationTiming(peakVelocity, myMaxAcceleration, myMaxJerk, jerkTime, accelerationTime);
+                    if (peakVelocity * accelerationTime > length) {
+                        high = peakVelocity;
+                    } else {
+                        low = peakVelocity;
+                    }
+                }
+                peakVelocity = low;
+                accelerationTiming(peakVelocity, myMaxAcceleration, myMaxJerk, jerkTime, accelerationTime);
+            }
+            cruiseTime = (length - peakVelocity * accelerationTime) / peakVelocity;
+        };
+
+        // total time of the profile (seconds)
+        double duration() const {
+            return 2 * accelerationTime + cruiseTime;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: sample
+        * Desc: setpoint at a given time since the start of the profile
+        * Param: seconds since the start of the profile
+        * Output: position, velocity and acceleration the mechanism should have at that time. Clamped to the end of the profile
+        */
+        ProfileState sample(double time) const {
+            ProfileState state;
+
+            if (time <= 0 || peakVelocity == 0) {
+                state.position = (time <= 0) ? 0 : fabs(distance);
+                state.velocity = 0;
+                state.acceleration = 0;
+            } else if (time < accelerationTime) {
+                state = accelerationState(time);
+            } else if (time < accelerationTime + cruiseTime) {
+                state.position = 0.5 * peakVelocity * accelerationTime + peakVelocity * (time - accelerationTime);
+                state.velocity = peakVelocity;
+                state.acceleration = 0;
+            } else if (time < duration()) {
+                // the deceleration phase is the acceleration phase played backwards from the end of the move
+                ProfileState mirrored = accelerationState(duration() - time);
+                state.position = fabs(distance) - mirrored.position;
+                state.velocity = mirrored.velocity;
+                state.acceleration = -mirrored.acceleration;
+            } else {
+                state.position = fabs(distance);
+                state.velocity = 0;
+                state.acceleration = 0;
+            }
+
+            state.position *= direction;
+            state.velocity *= direction;
+            state.acceleration *= direction;
+            return state;
+        };
+
+        bool isFinished(double time) const {
+            return time >= duration();
+        };
+        double getDistance() const {
+            return distance;
+        };
+};
+
+#endif
@@ -0,0 +1,156 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Command buffer that sends the outputs of a group of motors together, once per control tick
+* ------------------------------------------------------------------------
+*/
+
+#ifndef MOTOR_GROUP_H
+#define MOTOR_GROUP_H
+
+#include <stdint.h>
+
+#include "v5.h"
+#include "v5_vcs.h"
+
+/*
+* MotorGroup class. A control loop sets the output of every motor of the group (velocity, voltage or stop), then calls apply() once,
+* which sends all of them back to back so every motor of the group gets its new command at the same moment.
+* Outputs are signed, positive turns the mechanism forwards: motors added as reversed get the opposite direction, so callers no longer
+* flip directions themselves. apply() only sends the outputs that changed since they were last sent.
+*/
+class MotorGroup {
+    public:
+        static const int maxMotors = 4;
+
+    private:
+        enum Mode { MODE_NONE, MODE_VELOCITY, MODE_VOLTAGE, MODE_STOP };
+
+        /*
+        * mode / value / brake: output set for the next apply (percent of full speed or of full voltage, brake mode of a stop)
+        * sentMode / sentValue / sentBrake: output the motor got last
+        */
+        struct Output {
+            vex::motor *motor;
+            bool reversed;
+            Mode mode;
+            double value;
+            vex::brakeType brake;
+            Mode sentMode;
+            double sentValue;
+            vex::brakeType sentBrake;
+        };
+
+        Output outputs[maxMotors];
+        int count;
+        double maxVoltage;
+        uint32_t sent;
+        uint32_t skipped;
+
+    public:
+        // maxVoltage: motor voltage at 100 percent (volts)
+        MotorGroup(double myMaxVoltage) {
+            count = 0;
+            maxVoltage = myMaxVoltage;
+            sent = 0;
+            skipped = 0;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: add
+        * Desc: adds a motor to the group
+        * Param: the motor, true if it turns in reverse to drive the mechanism forwards
+        * Output: returns the motor's index in the group, or -1 if the group is full
+        */
+        int add(vex::motor &motor, bool reversed) {
+            if (count >= maxMotors) {
+                return -1;
+            }
+            Output &output = outputs[count];
+            output.motor = &motor;
+            output.reversed = reversed;
+            output.mode = MODE_NONE;
+            output.value = 0;
+            output.brake = vex::brakeType::brake;
+            output.sentMode = MODE_NONE;
+            output.sentValue = 0;
+            output.sentBrake = vex::brakeType::brake;
+            return count++;
+        };
+
+        // output of one motor for the next apply: velocity in percent of full speed [-100, 100]
+        void setVelocity(int index, double percent) {
+            outputs[index].mode = MODE_VELOCITY;
+            outputs[index].value = percent;
+        };
+        // voltage in percent of full voltage [-100, 100]
+        void setVoltage(int index, double percent) {
+            outputs[index].mode = MODE_VOLTAGE;
+            outputs[index].value = percent;
+        };
+        void stop(int index, vex::brakeType brake) {
+            outputs[index].mode = MODE_STOP;
+            outputs[index].value = 0;
+            outputs[index].brake = brake;
+        };
+        void stopAll(vex::brakeType brake) {
+            for (int i = 0; i < count; i++) {
+                stop(i, brake);
+            }
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: apply
+        * Desc: sends the outputs that changed since they were last sent, back to back
+        * Param: none
+        * Output: commands the motors
+        */
+        void apply() {
+            for (int i = 0; i < count; i++) {
+                Output &output = outputs[i];
+                if (output.mode == MODE_NONE ||
+                    (output.mode == output.sentMode && output.value == output.sentValue && output.brake == output.sentBrake)) {
+                    skipped++;
+                    continue;
+                }
+
+                vex::directionType direction = output.reversed ? vex::directionType::rev : vex::directionType::fwd;
+                if (output.mode == MODE_VELOCITY) {
+                    output.motor->spin(direction, output.value, vex::velocityUnits::pct);
+                } else if (output.mode == MODE_VOLTAGE) {
+                    output.motor->spin(direction, output.value / 100 * maxVoltage, vex::voltageUnits::volt);
+                } else {
+                    output.motor->stop(output.brake);
+                }
+                output.sentMode = output.mode;
+                output.sentValue = output.value;
+                output.sentBrake = output.brake;
+                sent++;
+            }
+        };
+
+        // makes the next apply send every output, e.g. after the motors were commanded without the group
+        void invalidate() {
+            for (int i = 0; i < count; i++) {
+                outputs[i].sentMode = MODE_NONE;
+            }
+        };
+
+        /*
+        * GET functions
+        */
+        int size() const {
+            return count;
+        };
+        // commands sent to the motors and unchanged outputs that were not sent again
+        uint32_t commandsSent() const {
+            return sent;
+        };
+        uint32_t commandsSkipped() const {
+            return skipped;
+        };
+};
+
+#endif
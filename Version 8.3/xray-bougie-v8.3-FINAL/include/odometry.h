@@ -0,0 +1,136 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Wheel odometry that keeps track of the robot's position and heading on the field
+* ------------------------------------------------------------------------
+*/
+
+#ifndef ODOMETRY_H
+#define ODOMETRY_H
+
+#include <math.h>
+
+/*
+* Position and heading of the robot on the field.
+* x: meters forward of the starting position, y: meters to the right of the starting position,
+* heading: degrees clockwise from the starting heading (same direction as a positive rotationalMove), not wrapped
+*/
+struct Pose {
+    double x;
+    double y;
+    double heading;
+};
+
+/*
+* Odometry class. Integrates the four base motor encoders into a field pose once per control tick.
+* The encoders are never reset: every update works on the change since the previous update, so resetting the pose
+* (setPose) does not touch the motors and motions can keep using absolute targets for the whole routine.
+* Each side of the drive is the average of its two motors. The right motors spin in reverse to drive forward, so their
+* readings are negated. Each update is integrated as an arc at the mean heading of the step.
+*/
+class Odometry {
+    private:
+        double wheelCircumference; // meters
+        double encoderTicksPerRotation; // encoder degrees per wheel rotation
+        double trackWidth; // effective distance between the left and right wheels (meters)
+
+        Pose pose;
+        double previousLeft = 0; // meters
+        double previousRight = 0; // meters
+        double leftVelocity = 0; // meters / second
+        double rightVelocity = 0; // meters / second
+        bool initialized = false;
+
+        double toMeters(double encoderDegrees) const {
+            return encoderDegrees / encoderTicksPerRotation * wheelCircumference;
+        };
+
+    public:
+        Odometry(double myWheelCircumference, double myEncoderTicksPerRotation, double myTrackWidth) {
+            wheelCircumference = myWheelCircumference;
+            encoderTicksPerRotation = myEncoderTicksPerRotation;
+            trackWidth = myTrackWidth;
+            pose.x = 0;
+            pose.y = 0;
+            pose.heading = 0;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: update
+        * Desc: integrates the encoder change since the previous update into the pose. The first call only records the starting readings
+        * Param:
+        *   - rotation of the top left, bottom left, top right and bottom right base motors (encoder degrees, as read from the motors)
+        *   - seconds since the previous update
+        * Output: updates the pose and side velocities
+        */
+        void update(double topLeft, double bottomLeft, double topRight, double bottomRight, double dt) {
+            double left = toMeters((topLeft + bottomLeft) / 2);
+            double right = -toMeters((topRight + bottomRight) / 2);
+
+            if (!initialized) {
+                previousLeft = left;
+                previousRight = right;
+                initialized = true;
+                return;
+            }
+
+            double deltaLeft = left - previousLeft;
+            double deltaRight = right - previousRight;
+            previousLeft = left;
+            previousRight = right;
+
+            double deltaDistance = (deltaLeft + deltaRight) / 2;
+            double deltaHeading = (deltaLeft - deltaRight) / trackWidth; // radians, clockwise
+            double midHeading = pose.heading * M_PI / 180 + deltaHeading / 2;
+
+            pose.x += deltaDistance * cos(midHeading);
+            pose.y += deltaDistance * sin(midHeading);
+            pose.heading += deltaHeading * 180 / M_PI;
+
+            if (dt > 0) {
+                leftVelocity = deltaLeft / dt;
+                rightVelocity = deltaRight / dt;
+            }
+        };
+
+        // move the robot to a known pose (e.g. its starting tile) without touching the encoders
+        void setPose(double x, double y, double heading) {
+            pose.x = x;
+            pose.y = y;
+            pose.heading = heading;
+        };
+
+        /*
+        * GET functions
+        */
+        const Pose &getPose() const {
+            return pose;
+        };
+        // signed distance from the robot to a point, measured along a given heading (degrees) (meters)
+        double distanceAlong(double x, double y, double heading) const {
+            double radians = heading * M_PI / 180;
+            return (x - pose.x) * cos(radians) + (y - pose.y) * sin(radians);
+        };
+        // forward speed of the robot (meters / second)
+        double getVelocity() const {
+            return (leftVelocity + rightVelocity) / 2;
+        };
+        // turning speed of the robot, clockwise (degrees / second)
+        double getAngularVelocity() const {
+            return (leftVelocity - rightVelocity) / trackWidth * 180 / M_PI;
+        };
+        // distance driven by each side since the first update, forwards positive (meters)
+        double getLeftDistance() const {
+            return previousLeft;
+        };
+        double getRightDistance() const {
+            return previousRight;
+        };
+        double getTrackWidth() const {
+            return trackWidth;
+        };
+};
+
+#endif
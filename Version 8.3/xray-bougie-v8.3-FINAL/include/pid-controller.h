@@ -0,0 +1,126 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: PID controller used by the closed loop motion primitives
+* ------------------------------------------------------------------------
+*/
+
+#ifndef PID_CONTROLLER_H
+#define PID_CONTROLLER_H
+
+/*
+* PidController class. Turns the error of a mechanism (target - current) into a motor command once per control tick.
+* T is the numeric type of the error and the output (double on the robot).
+*   - the integral is clamped to +/- integralLimit and stops growing while the output is saturated in the direction of the error (anti-windup)
+*   - the derivative is taken on the error and smoothed with a first order low-pass filter; derivativeFilter is the weight [0, 1) of the
+*     previous value, 0 for no filtering. The first tick after a reset has no derivative so a new target does not kick the output
+*   - the output is clamped to +/- outputLimit
+* All state lives in the object, update() does not allocate.
+*/
+template <typename T>
+class PidController {
+    private:
+        T kp;
+        T ki;
+        T kd;
+        T outputLimit;
+        T integralLimit;
+        T derivativeFilter;
+
+        T integral = 0;
+        T derivative = 0;
+        T previousError = 0;
+        T output = 0;
+        bool firstUpdate = true;
+
+        static T clamp(T value, T limit) {
+            if (value > limit) {
+                return limit;
+            }
+            if (value < -limit) {
+                return -limit;
+            }
+            return value;
+        };
+
+    public:
+        PidController(T myKp, T myKi, T myKd, T myOutputLimit, T myIntegralLimit, T myDerivativeFilter = 0) {
+            kp = myKp;
+            ki = myKi;
+            kd = myKd;
+            outputLimit = myOutputLimit;
+            integralLimit = myIntegralLimit;
+            derivativeFilter = myDerivativeFilter;
+        };
+
+        // forget the integral and derivative history, call when the target changes
+        void reset() {
+            integral = 0;
+            derivative = 0;
+            previousError = 0;
+            output = 0;
+            firstUpdate = true;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: update
+        * Desc: runs one control tick
+        * Param:
+        *   - error between the target and the current value
+        *   - seconds since the previous update
+        * Output: returns the clamped controller output
+        */
+        T update(T error, T dt) {
+            if (dt <= 0) {
+                return output;
+            }
+
+            if (firstUpdate) {
+                derivative = 0;
+                firstUpdate = false;
+            } else {
+                T rawDerivative = (error - previousError) / dt;
+                derivative = derivativeFilter * derivative + (1 - derivativeFilter) * rawDerivative;
+            }
+            previousError = error;
+
+            // only integrate while the output is not already pushing against its limit in the same direction
+            bool saturatedHigh = output >= outputLimit && error > 0;
+            bool saturatedLow = output <= -outputLimit && error < 0;
+            if (!saturatedHigh && !saturatedLow) {
+                integral = clamp(integral + error * dt, integralLimit);
+            }
+
+            output = clamp(kp * error + ki * integral + kd * derivative, outputLimit);
+            return output;
+        };
+
+        /*
+        * SET functions
+        */
+        void setGains(T myKp, T myKi, T myKd) {
+            kp = myKp;
+            ki = myKi;
+            kd = myKd;
+        };
+        void setOutputLimit(T myOutputLimit) {
+            outputLimit = myOutputLimit;
+        };
+
+        /*
+        * GET functions
+        */
+        T getOutput() const {
+            return output;
+        };
+        T getIntegral() const {
+            return integral;
+        };
+        T getDerivative() const {
+            return derivative;
+        };
+};
+
+#endif
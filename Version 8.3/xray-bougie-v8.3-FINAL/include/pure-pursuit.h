@@ -0,0 +1,175 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Pure pursuit path follower that steers the base along a list of field waypoints
+* ------------------------------------------------------------------------
+*/
+
+#ifndef PURE_PURSUIT_H
+#define PURE_PURSUIT_H
+
+#include <math.h>
+#include "odometry.h"
+
+/*
+* Field point of a path, same frame as Pose (meters)
+*/
+struct Waypoint {
+    double x;
+    double y;
+};
+
+/*
+* PurePursuit class. Follows a path of straight segments through the waypoints, starting from where the robot is when the path is set.
+* Every tick the robot aims at the point of the path one lookahead distance away and drives the arc that passes through it, so corners
+* become curves and the robot never has to stop and turn in place. The path is driven forwards only.
+* The path is copied into a fixed array, update() does not allocate.
+*/
+class PurePursuit {
+    public:
+        static const int maxWaypoints = 16;
+
+    private:
+        Waypoint points[maxWaypoints + 1]; // points[0] is the robot position when the path was set
+        int count = 0;
+        int segment = 0; // segment the robot is on: from points[segment] to points[segment + 1]
+        double lookahead;
+
+        // progress [0, 1] of the point closest to (x, y) on a segment
+        double progressOnSegment(int index, double x, double y) const {
+            double dx = points[index + 1].x - points[index].x;
+            double dy = points[index + 1].y - points[index].y;
+            double lengthSquared = dx * dx + dy * dy;
+            if (lengthSquared == 0) {
+                return 1;
+            }
+            double t = ((x - points[index].x) * dx + (y - points[index].y) * dy) / lengthSquared;
+            return fmax(0, fmin(1, t));
+        };
+
+        double segmentLength(int index) const {
+            return hypot(points[index + 1].x - points[index].x, points[index + 1].y - points[index].y);
+        };
+
+    public:
+        PurePursuit(double myLookahead) {
+            lookahead = myLookahead;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: setPath
+        * Desc: starts following a new path
+        * Param:
+        *   - pose of the robot now
+        *   - waypoints to drive through, in order (at most maxWaypoints, extra points are ignored)
+        *   - number of waypoints
+        * Output: none
+        */
+        void setPath(const Pose &pose, const Waypoint *path, int pathCount) {
+            if (pathCount > maxWaypoints) {
+                pathCount = maxWaypoints;
+            }
+            points[0].x = pose.x;
+            points[0].y = pose.y;
+            for (int i = 0; i < pathCount; i++) {
+                points[i + 1] = path[i];
+            }
+            count = pathCount + 1;
+            segment = 0;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: update
+        * Desc: advances to the segment the robot is on and works out the arc to drive this tick
+        * Param: pose of the robot
+        * Output: returns the curvature of the arc (1 / meters), positive to turn clockwise
+        */
+        double update(const Pose &pose) {
+            if (count < 2) {
+                return 0;
+            }
+
+            // move on to the next segment once the robot has passed the end of the current one
+            while (segment < count - 2 && progressOnSegment(segment, pose.x, pose.y) >= 1) {
+                segment++;
+            }
+
+            // walk the path from the closest point until one lookahead distance has been covered
+            double t = progressOnSegment(segment, pose.x, pose.y);
+            double remaining = lookahead;
+            int index = segment;
+            double length = segmentLength(index);
+            double along = length * (1 - t);
+            while (along < remaining && index < count - 2) {
+                remaining -= along;
+                index++;
+                length = segmentLength(index);
+                along = length;
+                t = 0;
+            }
+            Waypoint goal = points[index + 1];
+            if (along > remaining && length > 0) {
+                double goalProgress = t + remaining / length;
+                goal.x = points[index].x + (points[index + 1].x - points[index].x) * goalProgress;
+                goal.y = points[index].y + (points[index + 1].y - points[index].y) * goalProgress;
+            }
+
+            // curvature of the arc through the goal point, tangent to the robot's heading
+            double radians = pose.heading * M_PI / 180;
+            double dx = goal.x - pose.x;
+            double dy = goal.y - pose.y;
+            double lateral = -sin(radians) * dx + cos(radians) * dy; // to the right of the robot
+            double distanceSquared = dx * dx + dy * dy;
+            if (distanceSquared == 0) {
+                return 0;
+            }
+            return 2 * lateral / distanceSquared;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: remainingDistance
+        * Desc: path length left between the robot and the last waypoint
+        * Param: pose of the robot
+        * Output: meters
+        */
+        double remainingDistance(const Pose &pose) const {
+            if (count < 2) {
+                return 0;
+            }
+            double distance = segmentLength(segment) * (1 - progressOnSegment(segment, pose.x, pose.y));
+            for (int i = segment + 1; i < count - 1; i++) {
+                distance += segmentLength(i);
+            }
+            return distance;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: isFinished
+        * Desc: the robot has reached or driven past the last waypoint
+        * Param:
+        *   - pose of the robot
+        *   - distance to the last waypoint that counts as reached (meters)
+        * Output: true once the path is done
+        */
+        bool isFinished(const Pose &pose, double tolerance) const {
+            if (count < 2) {
+                return true;
+            }
+            const Waypoint &end = points[count - 1];
+            if (hypot(end.x - pose.x, end.y - pose.y) <= tolerance) {
+                return true;
+            }
+            return segment == count - 2 && progressOnSegment(segment, pose.x, pose.y) >= 1;
+        };
+
+        const Waypoint &endPoint() const {
+            return points[count - 1];
+        };
+        void setLookahead(double myLookahead) {
+            lookahead = myLookahead;
+        };
+};
+
+#endif
@@ -0,0 +1,109 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Fixed-size ring buffer of log messages, written by the control code and drained to the screen or SD card by a background task
+* ------------------------------------------------------------------------
+*/
+
+#ifndef RING_LOGGER_H
+#define RING_LOGGER_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+* RingLogger class. log() formats a message printf-style straight into the next free slot of a fixed array and returns; it never
+* allocates, blocks or touches a device, so the control loops can log on every tick. A low-priority task calls drain() to hand the
+* messages to the screen or SD card in the order they were logged.
+* One writer and one reader: the head index is only advanced by log() and the tail index only by drain(), and each side publishes its
+* index with release / acquire ordering, so the two need no lock. The robot's control tasks take turns and count as one writer.
+* When every slot is full, new messages are dropped and counted rather than overwriting ones the reader may be copying.
+*/
+class RingLogger {
+    public:
+        typedef uint64_t (*ClockFunction)(void); // current time in microseconds
+        typedef void (*SinkFunction)(void *context, uint64_t micros, const char *text); // receives one drained message
+
+        static const uint32_t slotCount = 64; // power of two
+        static const uint32_t slotSize = 64; // longest message including the terminating zero, longer ones are cut
+
+    private:
+        struct Slot {
+            uint64_t micros;
+            char text[slotSize];
+        };
+
+        ClockFunction clock;
+        Slot slots[slotCount];
+        uint32_t head; // messages logged so far, written by log()
+        uint32_t tail; // messages drained so far, written by drain()
+        uint32_t dropped;
+
+    public:
+        RingLogger(ClockFunction clockFunction) {
+            clock = clockFunction;
+            head = 0;
+            tail = 0;
+            dropped = 0;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: log
+        * Desc: formats a message into the next free slot
+        * Param: printf format and arguments
+        * Output: returns false if the buffer was full and the message was dropped
+        */
+        bool log(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+            uint32_t position = head;
+            if (position - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) >= slotCount) {
+                dropped++;
+                return false;
+            }
+
+            Slot &slot = slots[position % slotCount];
+            slot.micros = clock();
+            va_list args;
+            va_start(args, format);
+            vsnprintf(slot.text, slotSize, format, args);
+            va_end(args);
+
+            __atomic_store_n(&head, position + 1, __ATOMIC_RELEASE);
+            return true;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: drain
+        * Desc: hands the oldest messages to a sink function and frees their slots
+        * Param: sink function, context pointer handed to it, largest number of messages to drain
+        * Output: returns the number of messages drained
+        */
+        int drain(SinkFunction sink, void *context, int maxMessages) {
+            int drained = 0;
+            uint32_t position = tail;
+            uint32_t end = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+            while (position != end && drained < maxMessages) {
+                const Slot &slot = slots[position % slotCount];
+                sink(context, slot.micros, slot.text);
+                position++;
+                drained++;
+                __atomic_store_n(&tail, position, __ATOMIC_RELEASE);
+            }
+            return drained;
+        };
+
+        /*
+        * GET functions
+        */
+        // messages logged but not drained yet
+        uint32_t pending() const {
+            return __atomic_load_n(&head, __ATOMIC_ACQUIRE) - __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+        };
+        uint32_t droppedMessages() const {
+            return dropped;
+        };
+};
+
+#endif
@@ -0,0 +1,47 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: The set of gains and precision thresholds of the Robot's autonomous motions that the gain tuner searches
+* ------------------------------------------------------------------------
+*/
+
+#ifndef ROBOT_GAINS_H
+#define ROBOT_GAINS_H
+
+#include "tuned-gains.h"
+
+/*
+* Gains and precision thresholds of the Robot's autonomous motions (see tuned-gains.h for their units). The Robot starts with those of
+* tuned-gains.h; Robot::setGains replaces them, e.g. with a candidate of the gain tuner. The arc PIDs of radius turns use the linear PID gains
+*/
+struct RobotGains {
+    double kpLinear;
+    double kpRotational;
+    double linearPrecisionThreshold;
+    double rotationalPrecisionThreshold;
+    double armPivotThreshold;
+    double linearPidKp;
+    double linearPidKi;
+    double linearPidKd;
+    double rotationalPidKp;
+    double rotationalPidKi;
+    double rotationalPidKd;
+    double armPidKp;
+    double armPidKi;
+    double armPidKd;
+    double rampPidKp;
+    double rampPidKi;
+    double rampPidKd;
+};
+
+// gains and thresholds of tuned-gains.h
+static inline RobotGains tunedGains() {
+    RobotGains gains = {tunedKpLinear, tunedKpRotational, tunedLinearPrecisionThreshold, tunedRotationalPrecisionThreshold, tunedArmPivotThreshold,
+                        tunedLinearPidKp, tunedLinearPidKi, tunedLinearPidKd, tunedRotationalPidKp, tunedRotationalPidKi, tunedRotationalPidKd,
+                        tunedArmPidKp, tunedArmPidKi, tunedArmPidKd, tunedRampPidKp, tunedRampPidKi, tunedRampPidKd};
+    return gains;
+}
+
+#endif
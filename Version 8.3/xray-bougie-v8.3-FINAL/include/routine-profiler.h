@@ -0,0 +1,182 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Records how long each primitive of an autonomous routine takes
+* ------------------------------------------------------------------------
+*/
+
+#ifndef ROUTINE_PROFILER_H
+#define ROUTINE_PROFILER_H
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+* RoutineProfiler class. One instance is owned by the Robot. While an autonomous routine runs, every motion primitive and sleep records
+* when it started, when its mechanism reached the target and began settling, and when it finished. Records are kept in a fixed array,
+* so recording never allocates; primitives past maxRecords are only counted.
+* The control scheduler ticks also report whether the base was moving, which gives the time the base stood still during the routine.
+*/
+class RoutineProfiler {
+    public:
+        typedef uint64_t (*ClockFunction)(void); // current time in microseconds
+
+        static const int maxRecords = 64;
+
+        /*
+        * name: primitive that ran ("linearMove", "rotationalMove", "sleep", ...)
+        * argument: its main argument (meters, degrees, percent of the range, milliseconds; 1 for placing and 0 for retracting the ramp)
+        * startMicros / endMicros: when it started and finished, endMicros is 0 while it runs
+        * settleMicros: when its mechanism reached the target and began settling, 0 if it did not
+        * overshoot: farthest the mechanism went past the target, in the units of the primitive's error (meters for linearMove, base encoder
+        *   degrees for rotationalMove, degrees for armPivot), 0 if it did not overshoot or the primitive does not report it
+        */
+        struct Record {
+            const char *name;
+            double argument;
+            uint64_t startMicros;
+            uint64_t settleMicros;
+            uint64_t endMicros;
+            double overshoot;
+        };
+
+    private:
+        ClockFunction clock;
+        Record records[maxRecords];
+        int count;
+        int dropped;
+        bool running;
+        uint64_t routineStart;
+        uint64_t routineEnd;
+        uint64_t baseIdle;
+
+    public:
+        RoutineProfiler(ClockFunction clockFunction) {
+            clock = clockFunction;
+            count = 0;
+            dropped = 0;
+            running = false;
+            routineStart = 0;
+            routineEnd = 0;
+            baseIdle = 0;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: startRoutine
+        * Desc: clears the records of the previous routine and starts recording
+        * Param: none
+        * Output: none
+        */
+        void startRoutine() {
+            count = 0;
+            dropped = 0;
+            running = true;
+            routineStart = clock();
+            routineEnd = 0;
+            baseIdle = 0;
+        };
+
+        void finishRoutine() {
+            routineEnd = clock();
+            running = false;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: begin
+        * Desc: records the start of a primitive
+        * Param: name of the primitive (must stay valid, e.g. a string literal), its main argument
+        * Output: returns the record id for settling and end, or -1 if no routine is running or the records are full
+        */
+        int begin(const char *name, double argument) {
+            if (!running) {
+                return -1;
+            }
+            if (count >= maxRecords) {
+                dropped++;
+                return -1;
+            }
+            Record &record = records[count];
+            record.name = name;
+            record.argument = argument;
+            record.startMicros = clock();
+            record.settleMicros = 0;
+            record.endMicros = 0;
+            record.overshoot = 0;
+            return count++;
+        };
+
+        // marks the moment the primitive's mechanism reached the target and began settling. Only the first call counts
+        void settling(int id) {
+            if (id >= 0 && id < count && records[id].settleMicros == 0) {
+                records[id].settleMicros = clock();
+            }
+        };
+
+        // reports how far past the target the mechanism is (positive) on this tick. The record keeps the largest value
+        void overshot(int id, double amount) {
+            if (id >= 0 && id < count && records[id].endMicros == 0 && amount > records[id].overshoot) {
+                records[id].overshoot = amount;
+            }
+        };
+
+        void end(int id) {
+            if (id >= 0 && id < count && records[id].endMicros == 0) {
+                records[id].endMicros = clock();
+            }
+        };
+
+        // called once per control tick with whether the base is moving (a base motion is running or the wheels are turning)
+        void tick(bool baseBusy, double dt) {
+            if (running && !baseBusy) {
+                baseIdle += (uint64_t) (dt * 1000000);
+            }
+        };
+
+        /*
+        * GET functions
+        */
+        bool isRunning() const {
+            return running;
+        };
+        int recordCount() const {
+            return count;
+        };
+        const Record &record(int id) const {
+            return records[id];
+        };
+        int droppedRecords() const {
+            return dropped;
+        };
+        // length of the last routine, or of the running one so far
+        uint64_t routineMicros() const {
+            return (running ? clock() : routineEnd) - routineStart;
+        };
+        // time the base stood still while the routine ran
+        uint64_t baseIdleMicros() const {
+            return baseIdle;
+        };
+        // total time of the finished records with the given name, or of all of them for 0
+        uint64_t totalMicros(const char *name) const {
+            uint64_t total = 0;
+            for (int i = 0; i < count; i++) {
+                if (records[i].endMicros != 0 && (!name || strcmp(records[i].name, name) == 0)) {
+                    total += records[i].endMicros - records[i].startMicros;
+                }
+            }
+            return total;
+        };
+        // total time the finished records spent settling
+        uint64_t settleMicros() const {
+            uint64_t total = 0;
+            for (int i = 0; i < count; i++) {
+                if (records[i].endMicros != 0 && records[i].settleMicros != 0) {
+                    total += records[i].endMicros - records[i].settleMicros;
+                }
+            }
+            return total;
+        };
+};
+
+#endif
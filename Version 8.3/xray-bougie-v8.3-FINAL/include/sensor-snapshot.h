@@ -0,0 +1,57 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Readings of every motor, sonar and controller input of the robot, taken once per control tick
+* ------------------------------------------------------------------------
+*/
+
+#ifndef SENSOR_SNAPSHOT_H
+#define SENSOR_SNAPSHOT_H
+
+#include <stdint.h>
+
+/*
+* SensorSnapshot struct. The Robot reads every sensor into one snapshot at the start of each control tick, and odometry, the motions and
+* the driver loop all read the snapshot instead of querying the devices, so every decision in a tick sees the same readings.
+* Each quantity is one array indexed by Motor, Sonar or Axis, so a job that needs e.g. the four base positions reads adjacent values.
+*/
+struct SensorSnapshot {
+    enum Motor { BASE_TOP_LEFT, BASE_BOTTOM_LEFT, BASE_TOP_RIGHT, BASE_BOTTOM_RIGHT, LEFT_INTAKE, RIGHT_INTAKE, RAMP_LIFT, ARM_PIVOT };
+    enum Sonar { RIGHT_SONAR, LEFT_SONAR, BACK_SONAR };
+    enum Axis { AXIS1, AXIS2, AXIS3, AXIS4 };
+    enum Button {
+        BUTTON_L1, BUTTON_L2, BUTTON_R1, BUTTON_R2, BUTTON_UP, BUTTON_DOWN, BUTTON_LEFT, BUTTON_RIGHT, BUTTON_X, BUTTON_B, BUTTON_Y, BUTTON_A
+    };
+
+    static const int motorCount = 8;
+    static const int sonarCount = 3;
+    static const int axisCount = 4;
+    static const int buttonCount = 12;
+
+    /*
+    * timestampMicros: brain time the snapshot was read (microseconds)
+    * sequence: number of snapshots read so far, to tell a new snapshot from the previous one
+    * position: motor rotation (degrees), velocity: motor speed (percent), current: motor current (amps),
+    * temperature: motor temperature (celsius), voltage: motor voltage (volts)
+    * sonar: distance to the nearest object (meters)
+    * axis: controller stick positions (percent), buttons: bit (1 << Button) is set while the button is pressed
+    */
+    uint64_t timestampMicros;
+    uint32_t sequence;
+    double position[motorCount];
+    double velocity[motorCount];
+    double current[motorCount];
+    double temperature[motorCount];
+    double voltage[motorCount];
+    double sonar[sonarCount];
+    double axis[axisCount];
+    uint16_t buttons;
+
+    bool pressing(Button button) const {
+        return (buttons >> button) & 1;
+    };
+};
+
+#endif
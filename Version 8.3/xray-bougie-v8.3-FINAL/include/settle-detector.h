@@ -0,0 +1,88 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Detects when a mechanism has come to rest at its target
+* ------------------------------------------------------------------------
+*/
+
+#ifndef SETTLE_DETECTOR_H
+#define SETTLE_DETECTOR_H
+
+#include <math.h>
+
+/*
+* SettleDetector class. Fed once per control tick, from the start of a motion, with the position error and velocity of a mechanism
+* (base, arm or ramp). The mechanism counts as settled once both have stayed within tolerance for a number of consecutive ticks,
+* so a motion can finish as soon as the robot has actually stopped instead of after a fixed pause.
+* A mechanism pushed against a wall or a cube never gets within tolerance: once it has stood still short of its target for a number
+* of ticks (the timeout), the motion times out so the routine can continue.
+*/
+class SettleDetector {
+    private:
+        double errorTolerance;
+        double velocityTolerance;
+        int requiredTicks;
+        int timeoutTicks;
+
+        int settledTicks = 0;
+        int stalledTicks = 0;
+        int elapsedTicks = 0;
+
+    public:
+        SettleDetector(double myErrorTolerance, double myVelocityTolerance, int myRequiredTicks, int myTimeoutTicks) {
+            errorTolerance = myErrorTolerance;
+            velocityTolerance = myVelocityTolerance;
+            requiredTicks = myRequiredTicks;
+            timeoutTicks = myTimeoutTicks;
+        };
+
+        // start watching a new motion
+        void reset() {
+            settledTicks = 0;
+            stalledTicks = 0;
+            elapsedTicks = 0;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: update
+        * Desc: records one control tick
+        * Param:
+        *   - error between the target and the current position (any unit, same as the error tolerance)
+        *   - current velocity (any unit, same as the velocity tolerance)
+        * Output: returns true once the mechanism is settled or the timeout has run out
+        */
+        bool update(double error, double velocity) {
+            elapsedTicks++;
+            bool still = fabs(velocity) <= velocityTolerance;
+            if (fabs(error) <= errorTolerance && still) {
+                settledTicks++;
+            } else {
+                settledTicks = 0;
+            }
+            if (fabs(error) > errorTolerance && still) {
+                stalledTicks++;
+            }
+            return isSettled() || isTimedOut();
+        };
+
+        bool isSettled() const {
+            return settledTicks >= requiredTicks;
+        };
+        // the mechanism stood still short of its target for the timeout (ticks in all since the last reset)
+        bool isTimedOut() const {
+            return timeoutTicks > 0 && stalledTicks >= timeoutTicks;
+        };
+        // number of ticks watched since the last reset
+        int ticks() const {
+            return elapsedTicks;
+        };
+
+        void setTolerances(double myErrorTolerance, double myVelocityTolerance) {
+            errorTolerance = myErrorTolerance;
+            velocityTolerance = myVelocityTolerance;
+        };
+};
+
+#endif
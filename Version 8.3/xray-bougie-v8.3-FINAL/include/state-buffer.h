@@ -0,0 +1,75 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Latest-value buffer that hands state from the control task to a slower task without locking
+* ------------------------------------------------------------------------
+*/
+
+#ifndef STATE_BUFFER_H
+#define STATE_BUFFER_H
+
+#include <stdint.h>
+
+/*
+* StateBuffer class. The writer (e.g. the control task) fills the slot returned by edit() and calls publish(); the reader (e.g. the screen
+* task) calls read() whenever it likes and gets the latest published state. Three slots rotate between the writer, the reader and the latest
+* published state, handed over with one atomic exchange each, so neither side ever waits for the other or sees a half written state, however
+* long the reader takes. A plain double buffer would need a lock or retries once the reader is slower than the writer.
+* One writer and one reader. edit() returns a slot with an older state in it, so the writer fills every field before publishing.
+*/
+template <typename T>
+class StateBuffer {
+    private:
+        static const uint32_t slotMask = 3;
+        static const uint32_t freshBit = 4; // set in latest while it holds a state the reader has not taken yet
+
+        T slots[3];
+        uint32_t writing; // slot the writer fills, only used by the writer
+        uint32_t latest; // slot with the latest published state, exchanged by both sides
+        uint32_t reading; // slot the reader reads, only used by the reader
+        uint32_t published; // states published so far
+
+    public:
+        StateBuffer() {
+            writing = 0;
+            latest = 1;
+            reading = 2;
+            published = 0;
+        };
+
+        // slot to fill with the next state
+        T &edit() {
+            return slots[writing];
+        };
+
+        // makes the filled slot the latest state and takes the previous latest slot to fill next
+        void publish() {
+            writing = __atomic_exchange_n(&latest, writing | freshBit, __ATOMIC_ACQ_REL) & slotMask;
+            __atomic_store_n(&published, published + 1, __ATOMIC_RELEASE);
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: read
+        * Desc: takes the latest published state if there is a newer one than the reader has
+        * Param: none
+        * Output: returns the latest state. It stays valid and unchanged until the next read()
+        */
+        const T &read() {
+            if (__atomic_load_n(&latest, __ATOMIC_ACQUIRE) & freshBit) {
+                reading = __atomic_exchange_n(&latest, reading, __ATOMIC_ACQ_REL) & slotMask;
+            }
+            return slots[reading];
+        };
+
+        /*
+        * GET functions
+        */
+        // states published so far, 0 until the writer has published one (read() then returns a slot the writer never filled)
+        uint32_t publishCount() const {
+            return __atomic_load_n(&published, __ATOMIC_ACQUIRE);
+        };
+};
+
+#endif
@@ -0,0 +1,236 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Binary telemetry log of the robot: one fixed-size record per control tick, collected in blocks and written to the SD card by a
+*       background task
+* ------------------------------------------------------------------------
+*/
+
+#ifndef TELEMETRY_RECORDER_H
+#define TELEMETRY_RECORDER_H
+
+#include <stdint.h>
+
+#include "sensor-snapshot.h"
+
+/*
+* TelemetryRecorder class. The control loop fills one Record per tick in place (next(), then commit()), straight into a fixed array of
+* blocks; it never allocates, formats text or touches the SD card. A full block is handed to a low-priority task, whose flush() writes the
+* file header once and then every full block with one write each, so the card is written in a few large appends instead of per tick.
+* One writer and one reader like RingLogger: the filled block count is only advanced by the control loop and the written block count only
+* by flush(), each published with release / acquire ordering. When every block is waiting for the card, records are dropped and counted.
+*
+* File format (little endian, the byte order of the brain and of the host tools): one Header, then Records until the end of the file.
+* The header carries its own size and the record size, so a reader can skip fields added by later versions; change version whenever the
+* meaning of an existing field changes.
+*/
+class TelemetryRecorder {
+    public:
+        typedef bool (*WriteFunction)(void *context, const uint8_t *data, uint32_t length, bool create); // create: start a new file
+
+        static const uint32_t magic = 0x54425258; // "XRBT"
+        static const uint16_t version = 1;
+        static const int recordsPerBlock = 32;
+        static const uint32_t blockCount = 8; // power of two
+
+        // what the robot is doing during a record: the running base motion if there is one, else the blocking primitive or driver control
+        enum Primitive {
+            PRIMITIVE_NONE, PRIMITIVE_LINEAR_MOVE, PRIMITIVE_ROTATIONAL_MOVE, PRIMITIVE_RADIUS_TURN, PRIMITIVE_FOLLOW_PATH,
+            PRIMITIVE_LINEAR_SONAR_MOVE, PRIMITIVE_SLEEP, PRIMITIVE_DRIVER, primitiveCount
+        };
+        enum Flag { FLAG_ARM_MOTION = 1, FLAG_RAMP_MOTION = 2, FLAG_AUTONOMOUS = 4 };
+
+        /*
+        * headerSize / recordSize: sizeof(Header) and sizeof(Record) of the program that wrote the file
+        * periodMicros: control tick period, startMicros: brain time of the first record (microseconds)
+        * armPivotLowerAngle ... rampLiftUpperAngle: limits of the arm pivot and ramp lift motors for this run (degrees)
+        */
+        struct Header {
+            uint32_t magic;
+            uint16_t version;
+            uint16_t headerSize;
+            uint16_t recordSize;
+            uint8_t motorCount;
+            uint8_t sonarCount;
+            uint32_t periodMicros;
+            uint64_t startMicros;
+            float armPivotLowerAngle;
+            float armPivotUpperAngle;
+            float rampLiftLowerAngle;
+            float rampLiftUpperAngle;
+        };
+
+        /*
+        * micros: time since Header::startMicros
+        * position / velocity / current / temperature: SensorSnapshot values of each motor (degrees, percent, amps, celsius)
+        * sonarMillimeters: sonar distances, axis: controller axes (percent), buttons: SensorSnapshot::buttons
+        * primitive: a Primitive, flags: Flag bits
+        * dropped: records dropped before this one because the card fell behind (saturates at 65535)
+        */
+        struct Record {
+            uint32_t micros;
+            float position[SensorSnapshot::motorCount];
+            float velocity[SensorSnapshot::motorCount];
+            float current[SensorSnapshot::motorCount];
+            uint16_t sonarMillimeters[SensorSnapshot::sonarCount];
+            uint16_t buttons;
+            int8_t axis[SensorSnapshot::axisCount];
+            uint8_t temperature[SensorSnapshot::motorCount];
+            uint8_t primitive;
+            uint8_t flags;
+            uint16_t dropped;
+        };
+
+        static_assert(sizeof(Header) == 40, "telemetry header layout changed, update version");
+        static_assert(sizeof(Record) == 124, "telemetry record layout changed, update version");
+
+    private:
+        struct Block {
+            Record records[recordsPerBlock];
+            int count;
+        };
+
+        Header header;
+        Block blocks[blockCount];
+        bool recording;
+        bool headerPending;
+        int fill; // records in the block being filled
+        uint32_t filled; // blocks handed to the writer so far, written by commit()
+        uint32_t written; // blocks written so far, written by flush()
+        uint32_t dropped;
+        uint32_t failed;
+
+    public:
+        TelemetryRecorder() {
+            recording = false;
+            headerPending = false;
+            fill = 0;
+            filled = 0;
+            written = 0;
+            dropped = 0;
+            failed = 0;
+        };
+
+        static const char *primitiveName(int primitive) {
+            static const char *names[primitiveCount] = {
+                "none", "linearMove", "rotationalMove", "radiusTurn", "followPath", "linearSonarMove", "sleep", "driver"
+            };
+            return primitive >= 0 && primitive < primitiveCount ? names[primitive] : "unknown";
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: start
+        * Desc: starts a new recording. Call before the writer task runs, the next flush() starts a new file with the header
+        * Param: brain time of the first record and control tick period (microseconds), arm pivot and ramp lift limits (degrees)
+        * Output: none
+        */
+        void start(uint64_t startMicros, uint32_t periodMicros, double armLower, double armUpper, double rampLower, double rampUpper) {
+            header.magic = magic;
+            header.version = version;
+            header.headerSize = sizeof(Header);
+            header.recordSize = sizeof(Record);
+            header.motorCount = SensorSnapshot::motorCount;
+            header.sonarCount = SensorSnapshot::sonarCount;
+            header.periodMicros = periodMicros;
+            header.startMicros = startMicros;
+            header.armPivotLowerAngle = armLower;
+            header.armPivotUpperAngle = armUpper;
+            header.rampLiftLowerAngle = rampLower;
+            header.rampLiftUpperAngle = rampUpper;
+            fill = 0;
+            filled = 0;
+            written = 0;
+            dropped = 0;
+            failed = 0;
+            headerPending = true;
+            recording = true;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: next
+        * Desc: returns the record to fill for this tick. Fill every field, then call commit()
+        * Param: none
+        * Output: the record, or 0 if not recording or every block is waiting for the writer (the record is dropped and counted)
+        */
+        Record *next() {
+            if (!recording) {
+                return 0;
+            }
+            if (fill == 0 && filled - __atomic_load_n(&written, __ATOMIC_ACQUIRE) >= blockCount) {
+                dropped++;
+                return 0;
+            }
+            Record *record = &blocks[filled % blockCount].records[fill];
+            record->dropped = dropped < 65535 ? dropped : 65535;
+            return record;
+        };
+
+        // adds the record returned by next() to the block, and hands the block to the writer once it is full
+        void commit() {
+            if (++fill == recordsPerBlock) {
+                closeBlock();
+            }
+        };
+
+        // hands the block being filled to the writer even if it is not full, e.g. before the program ends
+        void closeBlock() {
+            if (fill > 0) {
+                blocks[filled % blockCount].count = fill;
+                fill = 0;
+                __atomic_store_n(&filled, filled + 1, __ATOMIC_RELEASE);
+            }
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: flush
+        * Desc: writes the header of a new recording and every block handed to the writer, then frees the blocks
+        * Param: function that writes to the file, context pointer handed to it
+        * Output: returns the number of blocks written
+        */
+        int flush(WriteFunction write, void *context) {
+            if (headerPending) {
+                if (!write(context, (const uint8_t *) &header, sizeof(Header), true)) {
+                    failed++;
+                }
+                headerPending = false;
+            }
+            int count = 0;
+            uint32_t position = written;
+            uint32_t end = __atomic_load_n(&filled, __ATOMIC_ACQUIRE);
+            while (position != end) {
+                const Block &block = blocks[position % blockCount];
+                if (!write(context, (const uint8_t *) block.records, block.count * sizeof(Record), false)) {
+                    failed++;
+                }
+                position++;
+                count++;
+                __atomic_store_n(&written, position, __ATOMIC_RELEASE);
+            }
+            return count;
+        };
+
+        /*
+        * GET functions
+        */
+        bool isRecording() const {
+            return recording;
+        };
+        const Header &fileHeader() const {
+            return header;
+        };
+        // blocks handed to the writer but not written yet
+        uint32_t blocksPending() const {
+            return __atomic_load_n(&filled, __ATOMIC_ACQUIRE) - __atomic_load_n(&written, __ATOMIC_ACQUIRE);
+        };
+        uint32_t recordsDropped() const {
+            return dropped;
+        };
+        // writes the card did not take completely
+        uint32_t writesFailed() const {
+            return failed;
+        };
+};
+
+#endif
@@ -0,0 +1,224 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Timeline of the primitives and control ticks of a session, exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+* ------------------------------------------------------------------------
+*/
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+* TraceRecorder class. begin() / end() (or a TraceScope) record when a primitive started and how long it ran, complete() records a span
+* measured elsewhere such as a control tick. Events go into a fixed array that is only cleared by start(), so recording never allocates;
+* once it is full, new events are dropped and counted. Each event belongs to a track, which a trace viewer shows as its own row:
+* spans that overlap in time (a base motion while the routine sleeps, the arm moving during a base motion) go on different tracks.
+* writeJson() writes the events in the Chrome Trace Event format in small pieces, so a background task can put it on the SD card.
+* Event ids carry the session they were begun in, so ending an event of an earlier session (e.g. a motion cut short by field control)
+* does nothing.
+*/
+class TraceRecorder {
+    public:
+        typedef uint64_t (*ClockFunction)(void); // current time in microseconds
+        typedef bool (*WriteFunction)(void *context, const uint8_t *data, uint32_t length, bool create); // create: start a new file
+
+        static const int maxEvents = 8192;
+        static const int maxTracks = 8;
+
+    private:
+        static const uint32_t running = 0xffffffff; // duration of an event that has not ended
+
+        /*
+        * name: what ran (must stay valid, e.g. a string literal), startMicros: brain time it started, durationMicros: how long it ran
+        * track: row it is shown on, argument: its main argument, labelled by the track's argument name
+        */
+        struct Event {
+            const char *name;
+            uint64_t startMicros;
+            uint32_t durationMicros;
+            uint8_t track;
+            double argument;
+        };
+
+        ClockFunction clock;
+        Event events[maxEvents];
+        const char *trackNames[maxTracks];
+        const char *argumentNames[maxTracks];
+        int count;
+        uint32_t dropped;
+        bool recording;
+        int session;
+        uint64_t startMicros;
+        uint64_t stopMicros;
+        char output[1024];
+        int outputLength;
+
+        // appends to the output piece, writing the piece out first if the text may not fit
+        bool print(WriteFunction write, void *context, bool &create, const char *format, ...) __attribute__((format(printf, 5, 6))) {
+            if (outputLength > (int) sizeof(output) - 256 && !flushOutput(write, context, create)) {
+                return false;
+            }
+            va_list args;
+            va_start(args, format);
+            int length = vsnprintf(output + outputLength, sizeof(output) - outputLength, format, args);
+            va_end(args);
+            outputLength += length < (int) sizeof(output) - outputLength ? length : (int) sizeof(output) - outputLength - 1;
+            return true;
+        };
+        bool flushOutput(WriteFunction write, void *context, bool &create) {
+            bool written = write(context, (const uint8_t *) output, outputLength, create);
+            create = false;
+            outputLength = 0;
+            return written;
+        };
+
+    public:
+        TraceRecorder(ClockFunction clockFunction) {
+            clock = clockFunction;
+            for (int i = 0; i < maxTracks; i++) {
+                trackNames[i] = 0;
+                argumentNames[i] = "argument";
+            }
+            count = 0;
+            dropped = 0;
+            recording = false;
+            session = 0;
+            startMicros = 0;
+            stopMicros = 0;
+            outputLength = 0;
+        };
+
+        // names a track: the row title in the viewer and the label of its events' argument
+        void setTrack(int track, const char *name, const char *argumentName) {
+            if (track >= 0 && track < maxTracks) {
+                trackNames[track] = name;
+                argumentNames[track] = argumentName;
+            }
+        };
+
+        // clears the events of the previous session and starts recording
+        void start() {
+            count = 0;
+            dropped = 0;
+            session = (session + 1) & 0x7fff;
+            startMicros = clock();
+            recording = true;
+        };
+
+        // stops recording. Events still running are exported as ending here
+        void stop() {
+            if (recording) {
+                stopMicros = clock();
+                recording = false;
+            }
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: begin
+        * Desc: records the start of a span
+        * Param: name (must stay valid, e.g. a string literal), track, main argument
+        * Output: returns the event id for end(), or -1 if not recording or the trace is full
+        */
+        int begin(const char *name, int track, double argument) {
+            return complete(name, track, clock(), running, argument);
+        };
+
+        void end(int id) {
+            int index = id & 0xffff;
+            if (id >= 0 && (id >> 16) == session && index < count && events[index].durationMicros == running) {
+                events[index].durationMicros = (uint32_t) (clock() - events[index].startMicros);
+            }
+        };
+
+        // records a span that has already been measured. Returns its event id, or -1 if it was not recorded
+        int complete(const char *name, int track, uint64_t start, uint32_t durationMicros, double argument) {
+            if (!recording) {
+                return -1;
+            }
+            if (count >= maxEvents) {
+                dropped++;
+                return -1;
+            }
+            Event &event = events[count];
+            event.name = name;
+            event.startMicros = start;
+            event.durationMicros = durationMicros;
+            event.track = track;
+            event.argument = argument;
+            return (session << 16) | count++;
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: writeJson
+        * Desc: writes the recorded events as a Chrome trace (JSON object format). Times are relative to start(). Call once recording stopped
+        * Param: function that writes to the file, context pointer handed to it
+        * Output: returns false if a write failed
+        */
+        bool writeJson(WriteFunction write, void *context) {
+            bool create = true;
+            bool ok = true;
+            outputLength = 0;
+            ok &= print(write, context, create, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+            ok &= print(write, context, create, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"robot\"}}");
+            for (int track = 0; track < maxTracks; track++) {
+                if (trackNames[track]) {
+                    ok &= print(write, context, create, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                                track, trackNames[track]);
+                    ok &= print(write, context, create, ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"sort_index\":%d}}",
+                                track, track);
+                }
+            }
+            uint64_t end = recording ? clock() : stopMicros;
+            for (int i = 0; i < count; i++) {
+                const Event &event = events[i];
+                uint32_t duration = event.durationMicros != running ? event.durationMicros : (uint32_t) (end - event.startMicros);
+                ok &= print(write, context, create, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu,\"dur\":%lu,\"args\":{\"%s\":%.6g}}",
+                            event.name, event.track, (unsigned long long) (event.startMicros - startMicros), (unsigned long) duration,
+                            argumentNames[event.track < maxTracks ? event.track : 0], event.argument);
+            }
+            ok &= print(write, context, create, "\n],\"otherData\":{\"droppedEvents\":%lu}}\n", (unsigned long) dropped);
+            ok &= flushOutput(write, context, create);
+            return ok;
+        };
+
+        /*
+        * GET functions
+        */
+        bool isRecording() const {
+            return recording;
+        };
+        bool isFull() const {
+            return count >= maxEvents;
+        };
+        int eventCount() const {
+            return count;
+        };
+        uint32_t droppedEvents() const {
+            return dropped;
+        };
+};
+
+/*
+* TraceScope class. Records a span on a TraceRecorder from its construction to the end of the enclosing scope
+*/
+class TraceScope {
+    private:
+        TraceRecorder &trace;
+        int id;
+
+    public:
+        TraceScope(TraceRecorder &myTrace, const char *name, int track, double argument) : trace(myTrace) {
+            id = trace.begin(name, track, argument);
+        };
+        ~TraceScope() {
+            trace.end(id);
+        };
+};
+
+#endif
@@ -0,0 +1,33 @@
+/*
+* ------------------------------------------------------------------------
+* Project: xray-bougie-v8.3
+* Author: Shaw-Sean Yang
+* Date: 10/17/2026
+* Desc: Gains and precision thresholds of the Robot's autonomous motions and the gains of their PIDs. Generated by the gain tuner
+*       (host/src/gain-tuner.cpp, make tune in host/): rerun it instead of editing the values by hand
+* ------------------------------------------------------------------------
+*/
+
+#ifndef TUNED_GAINS_H
+#define TUNED_GAINS_H
+
+// hand tuned on the robot
+static const double tunedKpLinear = 10; // percent per meter of wheel error
+static const double tunedKpRotational = 0.1; // percent per base encoder degree of wheel error
+static const double tunedLinearPrecisionThreshold = 0.01; // meters
+static const double tunedRotationalPrecisionThreshold = 10; // base encoder degrees
+static const double tunedArmPivotThreshold = 10; // arm motor degrees
+static const double tunedLinearPidKp = 800; // percent per meter
+static const double tunedLinearPidKi = 100; // percent per meter second
+static const double tunedLinearPidKd = 20; // percent per meter / second
+static const double tunedRotationalPidKp = 0.4; // percent per base encoder degree
+static const double tunedRotationalPidKi = 0.3; // percent per base encoder degree second
+static const double tunedRotationalPidKd = 0.01; // percent per base encoder degree / second
+static const double tunedArmPidKp = 2; // percent per arm motor degree
+static const double tunedArmPidKi = 1; // percent per arm motor degree second
+static const double tunedArmPidKd = 0.02; // percent per arm motor degree / second
+static const double tunedRampPidKp = 1.5; // percent per ramp motor degree
+static const double tunedRampPidKi = 0.5; // percent per ramp motor degree second
+static const double tunedRampPidKd = 0.01; // percent per ramp motor degree / second
+
+#endif
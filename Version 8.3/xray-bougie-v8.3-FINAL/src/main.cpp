@@ -10,15 +10,44 @@
 
 
 #include "robot-config.h"
-#include <sstream>
+#include "control-scheduler.h"
+#include "motion-handle.h"
+#include "settle-detector.h"
+#include "pid-controller.h"
+#include "motion-profile.h"
+#include "odometry.h"
+#include "pure-pursuit.h"
+#include "drive-feedforward.h"
+#include "routine-profiler.h"
+#include "tuned-gains.h"
+#include "robot-gains.h"
+#include "sensor-snapshot.h"
+#include "motor-group.h"
+#include "ring-logger.h"
+#include "telemetry-recorder.h"
+#include "trace-recorder.h"
+#include "latency-meter.h"
+#include "controller-input.h"
+#include "state-buffer.h"
 
 vex::competition Competition;
 
+/*
+* Clock and sleep functions handed to the control scheduler
+*/
+uint64_t brainMicros( void ) {
+    return vex::timer::systemHighResolution();
+}
+void brainSleep( uint32_t millis ) {
+    vex::task::sleep(millis);
+}
+
 /*
 * ScreenButton class for ScreenButton objects. One instance is created for every clickable menu button displayed on the screen.
 */
 
-/*class ScreenButton {
+#if 0
+class ScreenButton {
     private:
         // initialize instance variables with default values
         double xPos = 0;
@@ -46,7 +75,7 @@ vex::competition Competition;
         *   - text to display
         *   - value to return when pressed
         * Output: prints text to the robot Brain screen
-        *\
+        */
         ScreenButton(double myXPos, double myYPos, double myWidth, double myHeight, std::string myHexColor, std::string myDisplayText, int myReturnValue) {
             xPos = myXPos;
             yPos = myYPos;
@@ -72,7 +101,7 @@ vex::competition Competition;
         *   - cursor X position
         *   - cursor Y position
         * Output: returns the returnValue of the ScreenButton object that is pressed
-        *\
+        */
         static int whichButtonPressed(double cursorX, double cursorY) {
             
             // check the coordinates of each button to see which one matches the cursor position
@@ -105,7 +134,7 @@ vex::competition Competition;
         
         /*
         * Object Instance Variable GET functions
-        *\
+        */
         double getXPos() {
             return xPos;
         }
@@ -121,7 +150,8 @@ vex::competition Competition;
         double getReturnValue() {
             return returnValue;
         }  
-}; */
+};
+#endif
 
 
 /*
@@ -129,7 +159,12 @@ vex::competition Competition;
 * This allows variables to be shared among robot functions to avoid passing variables multiple times between functions.
 */
 
+class BenchRoutines;
+
 class Robot {
+    // the host bench runs check routines that are not match routines through the motion primitives (host/src/routine-runner.cpp)
+    friend class BenchRoutines;
+    
     private:
         /*
         * ------------------------------------------------------------------------
@@ -151,6 +186,52 @@ class Robot {
         * kpRotational: PID poportional constant (Kp)
         * linearPrecisionThreshold: predefined maximum difference between linear target distance and distance so far for the movement command to complete (meters)
         * rotationalPrecisionThreshold: predefined maximum difference between rotional target angle and angle so far for the movement command to complete (degrees)
+        * kpLinear / kpRotational / linearPrecisionThreshold / rotationalPrecisionThreshold / armPivotThreshold: generated into tuned-gains.h by the gain tuner
+        * linearPid / rotationalPid / armPid / rampPid: position controllers of the base, arm and ramp (percent of motor speed)
+        * baseMaxVelocity / baseMaxRotationalVelocity: base speed at 100 percent (meters / second, base encoder degrees / second)
+        * baseFeedforward: kS / kV / kA model of the base motors. Replaced from feedforwardFile once characterizeDrive has run on the robot
+        * maxMotorVoltage: motor voltage at 100 percent (volts)
+        * baseMotors: batched commands of the four base motors, in SensorSnapshot::Motor order
+        * linearMaxAcceleration / rotationalMaxAcceleration: acceleration limits of the base profiles (meters / second^2, base encoder degrees / second^2)
+        * linearProfile / rotationalProfile / baseProfileTime: profile of the running base motion and seconds since it started
+        * liftMaxVelocity: arm pivot and ramp lift speed at 100 percent (degrees / second)
+        * armMaxAcceleration / armMaxJerk / rampMaxAcceleration / rampMaxJerk: limits of the arm and ramp S-curve profiles
+        * armProfile / rampProfile / armProfileTime / rampProfileTime: S-curve profile of the running arm and ramp motions and seconds since they started
+        * controlScheduler: paces every control loop to a fixed 10 ms period and keeps the timing statistics of each loop
+        * baseMotion / armMotion / rampMotion: motion running in the background on each subsystem
+        * baseChannel / armChannel / rampChannel: completion state behind the MotionHandles of each subsystem
+        * settleVelocity: maximum motor speed (percent) for a mechanism to count as stopped
+        * rampSettleTolerance: maximum ramp lift error (degrees) to count as settled. The base and arm use their precision thresholds
+        * settleTicks: consecutive settled control ticks before a motion finishes
+        * settleTimeoutTicks: control ticks a mechanism may stand still short of its target (against a wall or a cube) before its motion finishes anyway
+        * encoderTicksPerDegree: base encoder degrees per degree of robot rotation in place (obtained experimentally)
+        * trackWidth: effective distance between the left and right wheels (meters)
+        * odometry: field pose of the robot, integrated from the base encoders every control tick
+        * targetPose: field pose the autonomous motions command. Each motion drives to it from the actual pose
+        * linearTargetX / linearTargetY / linearHeading: target point and heading of the running linear motion
+        * rotationalStartHeading: heading when the running rotational motion started (degrees)
+        * baseStartRotation: base encoder readings when the running base motion started
+        * pathFollower / pathLookahead / pathEndTolerance: pure pursuit follower of the running path motion, its lookahead and end distance (meters)
+        * pathFinalHeading / pathSpeed / pathVelocity: final heading, speed and last commanded velocity of the running path motion
+        * arcLeftLength / arcRightLength / arcLeftStart / arcRightStart: arc length of each side of the running radius turn and its start (meters)
+        * arcProfile / leftArcPid / rightArcPid: profile of the outer side of the running radius turn and the arc length controllers
+        * routineProfiler / baseRecord / armRecord / rampRecord: timing of every primitive of the running routine, and the record of each subsystem
+        * sensors: every motor, sonar and controller input, read once at the start of each control tick (readSensors)
+        * sensorMotors / sensorSonars / sensorAxes / sensorButtons: devices behind each SensorSnapshot index
+        * controlTaskPriority / screenTaskPriority / logTaskPriority: priorities of the control task (autonomousMain, driverMain), screenTask and logTask
+        * screenMillis / logDrainMillis: periods of screenTask and logTask
+        * logger / screenLines: runPrint messages waiting for logTask and for screenTask
+        * logToCard / logFile / logBatch: also append the drained messages to logFile on the SD card
+        * status / statusPublished: pose and control loop statistics published by the control task for screenTask
+        * statisticsPage / statisticsPageMillis / screenTouched / statisticsDrawn: control loop statistics page, toggled by touching the screen
+        * telemetry / telemetryFile / telemetryStarted: binary record of every control tick, written to the SD card by logTask
+        * trace / traceFile / pendingTraceFile / traceExportRequested: Chrome trace timeline of the session, written to the SD card by logTask
+        * baseTrace / armTrace / rampTrace / traceJobsMicros: trace event of the motion of each subsystem, and time the jobs of the current tick took
+        * foregroundPrimitive: blocking primitive the robot program is in when no base motion runs
+        * autonomousRunning: an autonomous routine is running
+        * latency / measureLatency / latencyReportMillis: controller input to motor command latency of each subsystem
+        * controllerInput: hands the controller inputs that changed to the handler of each subsystem
+        * baseButtons / baseAxes / intakeButtons / armButtons / rampButtons: inputs each handler reacts to
         */
     
         //bool autonomousSelected = false;
@@ -169,28 +250,28 @@ class Robot {
     
         double wheelCircumference = 0.319185814; // meters
         double encoderTicksPerRotation = 1100;
-        double errorBottomLeft;
-        double errorTopRight;
-        double errorBottomRight;
+        double errorBottomLeft = 0;
+        double errorTopRight = 0;
+        double errorBottomRight = 0;
     
         double traveledDistance = 0;
-        double kpLinear = 10;
+        double kpLinear = tunedKpLinear;
     
         double sonarDistance = 0;
     
         double traveledAngle = 0;
         double absoluteTargetAngle = 0;
-        double kpRotational = 0.1;
+        double kpRotational = tunedKpRotational;
 
-        double linearPrecisionThreshold = 0.01;
+        double linearPrecisionThreshold = tunedLinearPrecisionThreshold;
         double linearSonarPrecisionThreshold = 0.1;
-        double rotationalPrecisionThreshold = 10;
+        double rotationalPrecisionThreshold = tunedRotationalPrecisionThreshold;
 
         double intakeCircumference = 0.25215679274; // meters
     
         double armPivotIncrementalPercents [3] = {0, 0.8, 1}; // incremental percents used for incrementArmPivot function
         int currentArmIncrement = 0;
-        double armPivotThreshold = 10;
+        double armPivotThreshold = tunedArmPivotThreshold;
     
         vex::rotationUnits degreesUnit = vex::rotationUnits::deg;
         vex::velocityUnits percentVelocityUnit = vex::velocityUnits::pct;
@@ -198,30 +279,630 @@ class Robot {
         vex::directionType forwardDirection = vex::directionType::fwd;
         vex::directionType reverseDirection = vex::directionType::rev;
         vex::distanceUnits millimeterUnits = vex::distanceUnits::mm;
+        vex::voltageUnits voltUnit = vex::voltageUnits::volt;
+
+        ControlScheduler controlScheduler = ControlScheduler(brainMicros, brainSleep, 10);
+        enum ControlLoop { LOOP_AUTONOMOUS, LOOP_DRIVER, LOOP_CHARACTERIZATION };
+
+        enum BaseMotion { BASE_IDLE, BASE_LINEAR, BASE_ROTATIONAL, BASE_ARC, BASE_PATH };
+        BaseMotion baseMotion = BASE_IDLE;
+        double linearTargetDistance = 0;
+        double baseSpeed = 0;
+        MotionChannel baseChannel;
+
+        bool armMotion = false;
+        double armTargetAngle = 0;
+        double armSpeed = 0;
+        MotionChannel armChannel;
+
+        bool rampMotion = false;
+        bool rampPlaceOrRetract = true;
+        double rampSpeed = 0;
+        MotionChannel rampChannel;
+
+        double settleVelocity = 2;
+        double rampSettleTolerance = 20;
+        int settleTicks = 3;
+        int settleTimeoutTicks = 50;
+
+        SettleDetector baseSettle = SettleDetector(linearPrecisionThreshold, settleVelocity, settleTicks, settleTimeoutTicks);
+        SettleDetector armSettle = SettleDetector(armPivotThreshold, settleVelocity, settleTicks, settleTimeoutTicks);
+        SettleDetector rampSettle = SettleDetector(rampSettleTolerance, settleVelocity, settleTicks, settleTimeoutTicks);
+
+        PidController<double> linearPid = PidController<double>(tunedLinearPidKp, tunedLinearPidKi, tunedLinearPidKd, 100, 0.2, 0.5); // meters -> percent
+        PidController<double> rotationalPid = PidController<double>(tunedRotationalPidKp, tunedRotationalPidKi, tunedRotationalPidKd, 100, 50, 0.5); // base encoder degrees -> percent
+        PidController<double> armPid = PidController<double>(tunedArmPidKp, tunedArmPidKi, tunedArmPidKd, 100, 20, 0.5); // arm degrees -> percent
+        PidController<double> rampPid = PidController<double>(tunedRampPidKp, tunedRampPidKi, tunedRampPidKd, 100, 20, 0.5); // ramp degrees -> percent
+        PidController<double> leftArcPid = PidController<double>(tunedLinearPidKp, tunedLinearPidKi, tunedLinearPidKd, 100, 0.2, 0.5); // meters -> percent
+        PidController<double> rightArcPid = PidController<double>(tunedLinearPidKp, tunedLinearPidKi, tunedLinearPidKd, 100, 0.2, 0.5); // meters -> percent
+
+        double baseMaxVelocity = 1.045; // 600 rpm motors, 1100 encoder degrees per wheel rotation
+        double baseMaxRotationalVelocity = 3600;
+        DriveFeedforward baseFeedforward = DriveFeedforward(2.17, 95.3, 9.28); // fitted by characterizeDrive on the host simulation of the robot
+        const char *feedforwardFile = "drive-feedforward.bin";
+        double maxMotorVoltage = 12;
+        MotorGroup baseMotors = MotorGroup(maxMotorVoltage);
+        double linearMaxAcceleration = 4;
+        double rotationalMaxAcceleration = 6000;
+        TrapezoidalProfile linearProfile;
+        TrapezoidalProfile rotationalProfile;
+        double baseProfileTime = 0;
+
+        double liftMaxVelocity = 600;
+        double armMaxAcceleration = 2000;
+        double armMaxJerk = 15000;
+        double rampMaxAcceleration = 1000;
+        double rampMaxJerk = 6000;
+        SCurveProfile armProfile;
+        SCurveProfile rampProfile;
+        double armProfileTime = 0;
+        double rampProfileTime = 0;
+
+        double encoderTicksPerDegree = 7.678056;
+        double trackWidth = 360 * encoderTicksPerDegree / encoderTicksPerRotation * wheelCircumference / M_PI;
+        Odometry odometry = Odometry(wheelCircumference, encoderTicksPerRotation, trackWidth);
+        Pose targetPose = {0, 0, 0};
+        double linearTargetX = 0;
+        double linearTargetY = 0;
+        double linearHeading = 0;
+        double rotationalStartHeading = 0;
+        double baseStartRotation [4] = {0, 0, 0, 0};
+
+        SensorSnapshot sensors;
+        vex::motor *sensorMotors [SensorSnapshot::motorCount] = {&baseTopLeftMotor, &baseBottomLeftMotor, &baseTopRightMotor, &baseBottomRightMotor,
+                                                                 &leftIntakeMotor, &rightIntakeMotor, &rampLiftMotor, &armPivotMotor};
+        vex::sonar *sensorSonars [SensorSnapshot::sonarCount] = {&rightSonar, &leftSonar, &backSonar};
+        vex::controller::axis *sensorAxes [SensorSnapshot::axisCount] = {&Controller.Axis1, &Controller.Axis2, &Controller.Axis3, &Controller.Axis4};
+        vex::controller::button *sensorButtons [SensorSnapshot::buttonCount] = {&Controller.ButtonL1, &Controller.ButtonL2, &Controller.ButtonR1,
+                                                                                &Controller.ButtonR2, &Controller.ButtonUp, &Controller.ButtonDown,
+                                                                                &Controller.ButtonLeft, &Controller.ButtonRight, &Controller.ButtonX,
+                                                                                &Controller.ButtonB, &Controller.ButtonY, &Controller.ButtonA};
+
+        double arcLeftLength = 0;
+        double arcRightLength = 0;
+        double arcLeftStart = 0;
+        double arcRightStart = 0;
+        TrapezoidalProfile arcProfile;
+
+        double pathLookahead = 0.3;
+        double pathEndTolerance = 0.05;
+        PurePursuit pathFollower = PurePursuit(pathLookahead);
+        double pathFinalHeading = 0;
+        double pathSpeed = 0;
+        double pathVelocity = 0;
+
+        RoutineProfiler routineProfiler = RoutineProfiler(brainMicros);
+        int baseRecord = -1;
+        int armRecord = -1;
+        int rampRecord = -1;
+
+        int32_t controlTaskPriority = vex::task::taskPriorityHigh;
+        int32_t screenTaskPriority = vex::task::taskPriorityNormal - 2;
+        int32_t logTaskPriority = vex::task::taskPrioritylow;
+        bool tasksStarted = false;
+        vex::task screenTask;
+        uint32_t screenMillis = 100;
+        vex::task logTask;
+        uint32_t logDrainMillis = 50;
+
+        RingLogger logger = RingLogger(brainMicros);
+        RingLogger screenLines = RingLogger(brainMicros);
+        bool logToCard = false;
+        const char *logFile = "robot-log.txt";
+        char logBatch [RingLogger::slotCount * (RingLogger::slotSize + 16)];
+        int logBatchLength = 0;
+
+        /*
+        * pose: odometry pose, loop: control loop running (ControlScheduler::currentLoop), loops: statistics of every control loop
+        */
+        struct RobotStatus {
+            Pose pose;
+            int loop;
+            ControlScheduler::Statistics loops[ControlScheduler::maxLoops];
+        };
+        StateBuffer<RobotStatus> status;
+        uint64_t statusPublished = 0;
+        bool statisticsPage = false;
+        bool screenTouched = false;
+        uint32_t statisticsPageMillis = 500;
+        uint64_t statisticsDrawn = 0;
+
+        TelemetryRecorder telemetry;
+        bool telemetryStarted = false;
+        const char *telemetryFile = "telemetry.bin";
+        TelemetryRecorder::Primitive foregroundPrimitive = TelemetryRecorder::PRIMITIVE_NONE;
+        bool autonomousRunning = false;
+
+        enum TraceTrack { TRACK_ROUTINE = 1, TRACK_BASE, TRACK_ARM, TRACK_RAMP, TRACK_TICKS };
+        TraceRecorder trace = TraceRecorder(brainMicros);
+        const char *traceFile = 0;
+        const char *pendingTraceFile = 0;
+        bool traceExportRequested = false;
+        int baseTrace = -1;
+        int armTrace = -1;
+        int rampTrace = -1;
+        uint64_t traceJobsMicros = 0;
+
+        enum LatencyChannel { LATENCY_BASE, LATENCY_INTAKE, LATENCY_ARM, LATENCY_RAMP };
+        LatencyMeter latency = LatencyMeter(brainMicros);
+        bool measureLatency = false;
+        uint32_t latencyReportMillis = 5000;
+        uint64_t latencyReported = 0;
+
+        ControllerInput controllerInput = ControllerInput(1);
+        uint16_t baseButtons = 1 << SensorSnapshot::BUTTON_X | 1 << SensorSnapshot::BUTTON_B;
+        uint8_t baseAxes = 1 << SensorSnapshot::AXIS3 | 1 << SensorSnapshot::AXIS1;
+        uint16_t intakeButtons = 1 << SensorSnapshot::BUTTON_R1 | 1 << SensorSnapshot::BUTTON_R2 | 1 << SensorSnapshot::BUTTON_A |
+                                 1 << SensorSnapshot::BUTTON_X | 1 << SensorSnapshot::BUTTON_B;
+        uint16_t armButtons = 1 << SensorSnapshot::BUTTON_UP | 1 << SensorSnapshot::BUTTON_RIGHT | 1 << SensorSnapshot::BUTTON_DOWN;
+        uint16_t rampButtons = 1 << SensorSnapshot::BUTTON_L1 | 1 << SensorSnapshot::BUTTON_L2;
         
         /* ------------------------------------------------------------------------
         * Function: runPrint
         * Param: text to print, number of iterations to print
-        * Output: prints text to the robot Brain screen
+        * Output: logs text for the log task to print to the robot Brain screen. Use logger.log for formatted messages
         */
-        void runPrint(std::string text, int iterations) {
-            const char* char_name = text.c_str();
+        void runPrint(const char *text, int iterations) {
             for(int i = 0; i < iterations;i++) {
-                Brain.Screen.print(char_name);
-                Brain.Screen.newLine();
+                logger.log("%s", text);
             };
         };
-        void runPrint(std::string text) {
-            const char* char_name = text.c_str();
-            Brain.Screen.print(char_name);
-            Brain.Screen.newLine();
+        void runPrint(const char *text) {
+            logger.log("%s", text);
         };
         void runPrint(double numericalInput) {
-            std::ostringstream sstream;
-            sstream << numericalInput;
-            std::string printStatement = sstream.str();
-            runPrint(printStatement);
+            logger.log("%g", numericalInput);
         }
+        
+        /* ------------------------------------------------------------------------
+        * Function: writeLog
+        * Desc: body of the log task. Passes the logged messages on to the screen task and appends them to logFile if logToCard is set, writes
+        *       the full telemetry blocks to telemetryFile and finished traces to traceFile. The only task that writes to the SD card, so the
+        *       control loop never waits for it
+        * Param: none
+        * Output: never returns
+        */
+        void writeLog() {
+            while (true) {
+                logBatchLength = 0;
+                logger.drain(handleLogMessage, this, RingLogger::slotCount);
+                if (logToCard && logBatchLength > 0 && Brain.SDcard.isInserted()) {
+                    Brain.SDcard.appendfile(logFile, (uint8_t *) logBatch, logBatchLength);
+                }
+                writeCard();
+                vex::task::sleep(logDrainMillis);
+            }
+        };
+        static void handleLogMessage(void *context, uint64_t micros, const char *text) {
+            Robot &robot = *static_cast<Robot *>(context);
+            robot.screenLines.log("%s", text);
+            if (robot.logToCard) {
+                int space = (int) sizeof(robot.logBatch) - robot.logBatchLength;
+                int length = snprintf(robot.logBatch + robot.logBatchLength, space, "%.3f %s\n", micros / 1000000.0, text);
+                robot.logBatchLength += length < space ? length : space - 1;
+            }
+        };
+        static int logTaskEntry(void *robot) {
+            static_cast<Robot *>(robot)->writeLog();
+            return 0;
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: updateScreen
+        * Desc: body of the screen task. Touching the screen switches between the log and the statistics page; prints the messages the log
+        *       task passed on, or redraws the statistics page from the latest published status
+        * Param: none
+        * Output: never returns
+        */
+        void updateScreen() {
+            while (true) {
+                bool touched = Brain.Screen.pressing();
+                if (touched && !screenTouched) {
+                    statisticsPage = !statisticsPage;
+                    statisticsDrawn = 0;
+                    Brain.Screen.clearScreen();
+                    Brain.Screen.setCursor(1, 1);
+                }
+                screenTouched = touched;
+                if (statisticsPage && brainMicros() - statisticsDrawn >= (uint64_t) statisticsPageMillis * 1000) {
+                    drawLoopStatistics();
+                    statisticsDrawn = brainMicros();
+                }
+                screenLines.drain(printScreenLine, this, RingLogger::slotCount);
+                vex::task::sleep(screenMillis);
+            }
+        };
+        static void printScreenLine(void *context, uint64_t, const char *text) {
+            if (!static_cast<Robot *>(context)->statisticsPage) {
+                Brain.Screen.print("%s", text);
+                Brain.Screen.newLine();
+            }
+        };
+        static int screenTaskEntry(void *robot) {
+            static_cast<Robot *>(robot)->updateScreen();
+            return 0;
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: publishStatus
+        * Desc: control scheduler job that publishes the state the screen task shows, every screenMillis
+        * Param: none
+        * Output: updates status
+        */
+        void publishStatus() {
+            if (status.publishCount() > 0 && sensors.timestampMicros - statusPublished < (uint64_t) screenMillis * 1000) {
+                return;
+            }
+            statusPublished = sensors.timestampMicros;
+            RobotStatus &next = status.edit();
+            next.pose = odometry.getPose();
+            next.loop = controlScheduler.currentLoop();
+            for (int i = 0; i < ControlScheduler::maxLoops; i++) {
+                next.loops[i] = controlScheduler.statistics(i);
+            }
+            status.publish();
+        };
+        static void statusJob(void *robot, double) {
+            static_cast<Robot *>(robot)->publishStatus();
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: drawLoopStatistics
+        * Desc: draws the statistics page from the latest published status: pose, and ticks, overruns, working time, period and jitter of every
+        *       control loop that has run
+        * Param: none
+        * Output: prints to the robot Brain screen
+        */
+        void drawLoopStatistics() {
+            const RobotStatus &latest = status.read();
+            double period = controlScheduler.periodMicroseconds();
+            Brain.Screen.clearScreen();
+            Brain.Screen.setCursor(1, 1);
+            Brain.Screen.print("Control loops, %.0f ms period", period / 1000);
+            Brain.Screen.newLine();
+            if (status.publishCount() == 0) {
+                Brain.Screen.print("no control loop has run yet");
+                Brain.Screen.newLine();
+                return;
+            }
+            Brain.Screen.print("pose %.3f, %.3f m, %.1f deg", latest.pose.x, latest.pose.y, latest.pose.heading);
+            Brain.Screen.newLine();
+            for (int i = 0; i < ControlScheduler::maxLoops; i++) {
+                const ControlScheduler::Statistics &stats = latest.loops[i];
+                if (!controlScheduler.loopName(i) || stats.ticks == 0) {
+                    continue;
+                }
+                Brain.Screen.print("%s%s: %lu ticks, %lu overruns", controlScheduler.loopName(i), i == latest.loop ? "*" : "",
+                                   (unsigned long) stats.ticks, (unsigned long) stats.overruns);
+                Brain.Screen.newLine();
+                Brain.Screen.print(" busy avg %.2f p99 %.1f max %.2f ms", stats.meanBusyMicros() / 1000,
+                                   stats.busyPercentileMicros(0.99, (uint64_t) period) / 1000, stats.maxBusyMicros / 1000.0);
+                Brain.Screen.newLine();
+                Brain.Screen.print(" period %.2f-%.2f jitter %.3f/%.3f late %.2f ms", stats.minIntervalMicros / 1000.0,
+                                   stats.maxIntervalMicros / 1000.0, stats.rmsJitterMicros() / 1000, stats.maxJitterMicros / 1000.0,
+                                   stats.maxLatenessMicros / 1000.0);
+                Brain.Screen.newLine();
+            }
+            Brain.Screen.print("touch the screen for the log");
+            Brain.Screen.newLine();
+        };
+        
+        // makes the calling competition task the control task: it runs before the screen and log tasks whenever both are ready
+        void becomeControlTask() {
+            startTasks();
+            vex::this_thread::setPriority(controlTaskPriority);
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: recordTelemetry
+        * Desc: control scheduler job that adds this tick's sensor snapshot, controller inputs and running primitive to the telemetry.
+        *       Registered after the motion job so the record shows the primitive that ran on this tick
+        * Param: none
+        * Output: fills one telemetry record, unless telemetry is not recording or the card fell behind
+        */
+        void recordTelemetry() {
+            TelemetryRecorder::Record *record = telemetry.next();
+            if (!record) {
+                return;
+            }
+            record->micros = (uint32_t) (sensors.timestampMicros - telemetry.fileHeader().startMicros);
+            for (int i = 0; i < SensorSnapshot::motorCount; i++) {
+                record->position[i] = sensors.position[i];
+                record->velocity[i] = sensors.velocity[i];
+                record->current[i] = sensors.current[i];
+                double temperature = sensors.temperature[i];
+                record->temperature[i] = temperature <= 0 ? 0 : temperature >= 255 ? 255 : (uint8_t) (temperature + 0.5);
+            }
+            for (int i = 0; i < SensorSnapshot::sonarCount; i++) {
+                double millimeters = sensors.sonar[i] * 1000;
+                record->sonarMillimeters[i] = millimeters <= 0 ? 0 : millimeters >= 65535 ? 65535 : (uint16_t) (millimeters + 0.5);
+            }
+            for (int i = 0; i < SensorSnapshot::axisCount; i++) {
+                record->axis[i] = (int8_t) sensors.axis[i];
+            }
+            record->buttons = sensors.buttons;
+
+            TelemetryRecorder::Primitive primitive = foregroundPrimitive;
+            if (baseMotion == BASE_LINEAR) {
+                primitive = TelemetryRecorder::PRIMITIVE_LINEAR_MOVE;
+            } else if (baseMotion == BASE_ROTATIONAL) {
+                primitive = TelemetryRecorder::PRIMITIVE_ROTATIONAL_MOVE;
+            } else if (baseMotion == BASE_ARC) {
+                primitive = TelemetryRecorder::PRIMITIVE_RADIUS_TURN;
+            } else if (baseMotion == BASE_PATH) {
+                primitive = TelemetryRecorder::PRIMITIVE_FOLLOW_PATH;
+            }
+            record->primitive = primitive;
+            record->flags = (armMotion ? TelemetryRecorder::FLAG_ARM_MOTION : 0) | (rampMotion ? TelemetryRecorder::FLAG_RAMP_MOTION : 0) |
+                            (autonomousRunning ? TelemetryRecorder::FLAG_AUTONOMOUS : 0);
+            telemetry.commit();
+        };
+        static void telemetryJob(void *robot, double) {
+            static_cast<Robot *>(robot)->recordTelemetry();
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: recordTrace
+        * Desc: control scheduler job that adds the previous control tick to the trace, from its start to the moment its loop waited for
+        *       this tick, and starts a pending trace session. Registered last so traceJobsMicros covers the other jobs
+        * Param: none
+        * Output: records one trace event
+        */
+        void recordTrace() {
+            startPendingTrace();
+            trace.complete("tick", TRACK_TICKS, controlScheduler.previousTickMicros(), (uint32_t) controlScheduler.previousBusyMicros(),
+                           (double) traceJobsMicros);
+            traceJobsMicros = brainMicros() - controlScheduler.tickMicros();
+            if (trace.isFull()) {
+                finishTrace();
+            }
+        };
+        static void traceJob(void *robot, double) {
+            static_cast<Robot *>(robot)->recordTrace();
+        };
+        
+        // starts a new trace session written to the given file once it ends. A running session ends first, and if the card is still
+        // being written the new session starts on the first tick after that
+        void startTrace(const char *file) {
+            finishTrace();
+            pendingTraceFile = file;
+            startPendingTrace();
+        };
+        void startPendingTrace() {
+            if (pendingTraceFile && !__atomic_load_n(&traceExportRequested, __ATOMIC_ACQUIRE)) {
+                trace.start();
+                traceFile = pendingTraceFile;
+                pendingTraceFile = 0;
+            }
+        };
+        // ends the running trace session and has logTask write it
+        void finishTrace() {
+            if (trace.isRecording()) {
+                trace.stop();
+                __atomic_store_n(&traceExportRequested, true, __ATOMIC_RELEASE);
+            }
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: writeCard
+        * Desc: part of the log task. Writes the full telemetry blocks to telemetryFile and a finished trace to traceFile
+        * Param: none
+        * Output: writes to the SD card
+        */
+        void writeCard() {
+            if (__atomic_load_n(&telemetryStarted, __ATOMIC_ACQUIRE)) {
+                telemetry.flush(writeCardFile, (void *) telemetryFile);
+            }
+            if (__atomic_load_n(&traceExportRequested, __ATOMIC_ACQUIRE)) {
+                trace.writeJson(writeCardFile, (void *) traceFile);
+                __atomic_store_n(&traceExportRequested, false, __ATOMIC_RELEASE);
+            }
+        };
+        // writes to the SD card file named by the context, starting the file over if create is set
+        static bool writeCardFile(void *context, const uint8_t *data, uint32_t length, bool create) {
+            const char *file = static_cast<const char *>(context);
+            if (!Brain.SDcard.isInserted()) {
+                return false;
+            }
+            uint8_t *buffer = const_cast<uint8_t *>(data);
+            int32_t count = create ? Brain.SDcard.savefile(file, buffer, length) : Brain.SDcard.appendfile(file, buffer, length);
+            return count == (int32_t) length;
+        };
+        // starts recording telemetry into a new file the first time the robot program runs a routine or the driver loop
+        void startTelemetry() {
+            if (!telemetryStarted) {
+                telemetry.start(brainMicros(), (uint32_t) (controlScheduler.period() * 1000000), armPivotLowerAngle, armPivotUpperAngle,
+                                rampLiftLowerAngle, rampLiftUpperAngle);
+                __atomic_store_n(&telemetryStarted, true, __ATOMIC_RELEASE);
+            }
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: awaitIdle
+        * Desc: keeps the control scheduler ticking until the background motion running on a subsystem (if any) has finished
+        * Param: motion channel of the subsystem (baseChannel, armChannel or rampChannel)
+        * Output: returns once the subsystem is free for a new motion
+        */
+        void awaitIdle(const MotionChannel &channel) {
+            while (channel.isBusy()) {
+                controlScheduler.waitForNextTick();
+            }
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: sleepFor
+        * Desc: waits the given time while the background motions keep running (see ControlScheduler::sleepFor). Recorded by the routine profiler
+        * Param: milliseconds to wait
+        * Output: returns after at least the given time
+        */
+        void sleepFor(uint32_t millis) {
+            int record = routineProfiler.begin("sleep", millis);
+            TraceScope scope(trace, "sleep", TRACK_ROUTINE, millis);
+            foregroundPrimitive = TelemetryRecorder::PRIMITIVE_SLEEP;
+            controlScheduler.sleepFor(millis);
+            foregroundPrimitive = TelemetryRecorder::PRIMITIVE_NONE;
+            routineProfiler.end(record);
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: readSensors
+        * Desc: control scheduler job that reads every motor, sonar and controller input into the sensor snapshot. Registered first so every
+        *       other job and the control loop of the tick see the same readings
+        * Param: none
+        * Output: updates sensors
+        */
+        void readSensors() {
+            for (int i = 0; i < SensorSnapshot::motorCount; i++) {
+                vex::motor &motor = *sensorMotors[i];
+                sensors.position[i] = motor.rotation(degreesUnit);
+                sensors.velocity[i] = motor.velocity(percentVelocityUnit);
+                sensors.current[i] = motor.current(vex::currentUnits::amp);
+                sensors.temperature[i] = motor.temperature(vex::temperatureUnits::celsius);
+                sensors.voltage[i] = motor.voltage(voltUnit);
+            }
+            for (int i = 0; i < SensorSnapshot::sonarCount; i++) {
+                sensors.sonar[i] = sensorSonars[i]->distance(millimeterUnits) / 1000;
+            }
+            for (int i = 0; i < SensorSnapshot::axisCount; i++) {
+                sensors.axis[i] = sensorAxes[i]->position(percentUnit);
+            }
+            sensors.buttons = 0;
+            for (int i = 0; i < SensorSnapshot::buttonCount; i++) {
+                if (sensorButtons[i]->pressing()) {
+                    sensors.buttons |= 1 << i;
+                }
+            }
+            sensors.timestampMicros = brainMicros();
+            sensors.sequence++;
+        };
+        static void sensorJob(void *robot, double) {
+            static_cast<Robot *>(robot)->readSensors();
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: updateOdometry
+        * Desc: control scheduler job that integrates the base encoders into the field pose. Registered before the motion job so every motion tick
+        *       sees the pose of the same tick
+        * Param: seconds since the previous tick
+        * Output: updates odometry
+        */
+        void updateOdometry(double dt) {
+            odometry.update(sensors.position[SensorSnapshot::BASE_TOP_LEFT], sensors.position[SensorSnapshot::BASE_BOTTOM_LEFT],
+                            sensors.position[SensorSnapshot::BASE_TOP_RIGHT], sensors.position[SensorSnapshot::BASE_BOTTOM_RIGHT], dt);
+        };
+        static void odometryJob(void *robot, double dt) {
+            static_cast<Robot *>(robot)->updateOdometry(dt);
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: recordBaseStartRotation
+        * Desc: remembers the base encoder readings at the start of a base motion, in place of resetting the encoders
+        * Param: none
+        * Output: updates baseStartRotation
+        */
+        void recordBaseStartRotation() {
+            for (int i = 0; i < 4; i++) {
+                baseStartRotation[i] = sensors.position[SensorSnapshot::BASE_TOP_LEFT + i];
+            }
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: updateMotions
+        * Desc: control scheduler job that advances the background motion of each subsystem by one tick
+        * Param: seconds since the previous tick
+        * Output: finishes a subsystem's motion channel once its motion is done
+        */
+        void updateMotions(double dt) {
+            routineProfiler.tick(baseMotion != BASE_IDLE || baseVelocity() > settleVelocity, dt);
+            
+            if (baseMotion != BASE_IDLE) {
+                bool finished = false;
+                if (baseMotion == BASE_LINEAR) {
+                    finished = updateLinearMove(dt);
+                } else if (baseMotion == BASE_ROTATIONAL) {
+                    finished = updateRotationalMove(dt);
+                } else if (baseMotion == BASE_ARC) {
+                    finished = updateRadiusTurn(dt);
+                } else {
+                    finished = updateFollowPath(dt);
+                }
+                if (finished) {
+                    baseMotion = BASE_IDLE;
+                    baseChannel.finish();
+                    routineProfiler.end(baseRecord);
+                    trace.end(baseTrace);
+                }
+            }
+            if (armMotion && updateArmPivotUntilPercent(dt)) {
+                armMotion = false;
+                armChannel.finish();
+                routineProfiler.end(armRecord);
+                trace.end(armTrace);
+            }
+            if (rampMotion && updateRampLiftUntilExtrema(dt)) {
+                rampMotion = false;
+                rampChannel.finish();
+                routineProfiler.end(rampRecord);
+                trace.end(rampTrace);
+            }
+        };
+        static void motionJob(void *robot, double dt) {
+            static_cast<Robot *>(robot)->updateMotions(dt);
+        };
+
+        /* ------------------------------------------------------------------------
+        * Function: stopMotions
+        * Desc: ends the background motion of every subsystem without waiting for it, e.g. one left running by an autonomous routine that field
+        *       control cut short, so the motion job no longer commands the motors the driver loop now owns
+        * Param: none
+        * Output: finishes every motion channel. The motors keep their last command until the driver loop commands them
+        */
+        void stopMotions() {
+            if (baseMotion != BASE_IDLE) {
+                baseMotion = BASE_IDLE;
+                baseChannel.finish();
+                routineProfiler.end(baseRecord);
+                trace.end(baseTrace);
+            }
+            if (armMotion) {
+                armMotion = false;
+                armChannel.finish();
+                routineProfiler.end(armRecord);
+                trace.end(armTrace);
+            }
+            if (rampMotion) {
+                rampMotion = false;
+                rampChannel.finish();
+                routineProfiler.end(rampRecord);
+                trace.end(rampTrace);
+            }
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: baseVelocity
+        * Desc: speed of the fastest base wheel, used to tell when the base has stopped
+        * Param: none
+        * Output: returns the largest absolute base motor velocity in percent
+        */
+        double baseVelocity() {
+            double fastest = 0;
+            for (int i = SensorSnapshot::BASE_TOP_LEFT; i <= SensorSnapshot::BASE_BOTTOM_RIGHT; i++) {
+                fastest = fmax(fastest, fabs(sensors.velocity[i]));
+            }
+            return fastest;
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: stopBase
+        * Desc: stops the base at the end of an autonomous base motion. Brakes once the base has settled; holds it where it got stuck if the
+        *       settle timeout ended the motion, so it does not roll off a wall or a cube it was pushing against
+        * Param: none
+        * Output: stops robot base
+        */
+        void stopBase() {
+            baseMotors.stopAll(baseSettle.isSettled() ? vex::brakeType::brake : vex::brakeType::hold);
+            baseMotors.apply();
+        };
     
         /* ------------------------------------------------------------------------
         * Function: baseMove
@@ -236,100 +917,158 @@ class Robot {
             // if 0, stop motors
             if (linearAxis == 0 && rotationalAxis == 0) {
                 
-                baseTopLeftMotor.stop(vex::brakeType::brake);
-                baseBottomLeftMotor.stop(vex::brakeType::brake);
-                baseTopRightMotor.stop(vex::brakeType::brake);
-                baseBottomRightMotor.stop(vex::brakeType::brake);
+                baseMotors.stopAll(vex::brakeType::brake);
                 
             } else {
                 
-                baseTopLeftMotor.spin(forwardDirection, linearAxis + rotationalAxis, percentVelocityUnit);
-                baseBottomLeftMotor.spin(forwardDirection, linearAxis + rotationalAxis, percentVelocityUnit);
-                
-                // right motors are reverse to map properly to motor orientation on physical robot
-                baseTopRightMotor.spin(reverseDirection, linearAxis - rotationalAxis, percentVelocityUnit);
-                baseBottomRightMotor.spin(reverseDirection, linearAxis - rotationalAxis, percentVelocityUnit);
+                baseMotors.setVelocity(SensorSnapshot::BASE_TOP_LEFT, linearAxis + rotationalAxis);
+                baseMotors.setVelocity(SensorSnapshot::BASE_BOTTOM_LEFT, linearAxis + rotationalAxis);
+                baseMotors.setVelocity(SensorSnapshot::BASE_TOP_RIGHT, linearAxis - rotationalAxis);
+                baseMotors.setVelocity(SensorSnapshot::BASE_BOTTOM_RIGHT, linearAxis - rotationalAxis);
                 
             }
+            baseMotors.apply();
         };
         
         /* ------------------------------------------------------------------------
-        * Function: linearMove
-        * Desc: FOR forward / backwards AUTONOMOUS MOVEMENT.
+        * Function: baseVoltageMove
+        * Desc: drives each side of the base at a voltage
+        * Param: 
+        *   - leftPercent, rightPercent voltage of each side in percent of full voltage [-100, 100], positive to drive forwards
+        * Output: moves robot base
+        */
+        void baseVoltageMove(double leftPercent, double rightPercent) {
+            baseMotors.setVoltage(SensorSnapshot::BASE_TOP_LEFT, leftPercent);
+            baseMotors.setVoltage(SensorSnapshot::BASE_BOTTOM_LEFT, leftPercent);
+            baseMotors.setVoltage(SensorSnapshot::BASE_TOP_RIGHT, rightPercent);
+            baseMotors.setVoltage(SensorSnapshot::BASE_BOTTOM_RIGHT, rightPercent);
+            baseMotors.apply();
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: linearMoveAsync
+        * Desc: FOR forward / backwards AUTONOMOUS MOVEMENT. Starts the movement and returns right away; the movement runs on the control scheduler ticks.
+        *       Waits for any base movement that is still running first. The target is the field point targetDistance ahead of the previous target pose,
+        *       so the distance actually driven makes up for any under- or overshoot of the previous motions
         * Param: 
         *   - targetDistance for robot to travel by the end of the function in meters. Negative for backwards, Positive for forwards.
         *   - percentSpeed to be applied to the motors [0.0 - 1.0]
-        * Output: uses baseMove to move robot base
+        * Output: MotionHandle to await or poll the movement
         */
-        void linearMove(double targetDistance, double percentSpeed) {
+        MotionHandle linearMoveAsync(double targetDistance, double percentSpeed) {
+            awaitIdle(baseChannel);
             
-            baseTopLeftMotor.resetRotation();
-            baseBottomLeftMotor.resetRotation();
-            baseTopRightMotor.resetRotation();
-            baseBottomRightMotor.resetRotation();
-            
-            // set up distances
-            traveledDistance = (baseTopLeftMotor.rotation(degreesUnit)/encoderTicksPerRotation) * wheelCircumference;
-            double absoluteTargetDistance = targetDistance - traveledDistance;
+            double radians = targetPose.heading * M_PI / 180;
+            return linearMoveToAsync(targetPose.x + targetDistance * cos(radians), targetPose.y + targetDistance * sin(radians), percentSpeed);
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: linearMoveToAsync
+        * Desc: FOR forward / backwards AUTONOMOUS MOVEMENT to a field point. Drives straight along the target heading until the robot is level with the point.
+        *       Starts the movement and returns right away; the movement runs on the control scheduler ticks. Waits for any base movement that is still running first
+        * Param: 
+        *   - x and y of the field point in meters (see Pose)
+        *   - percentSpeed to be applied to the motors [0.0 - 1.0]
+        * Output: MotionHandle to await or poll the movement
+        */
+        MotionHandle linearMoveToAsync(double x, double y, double percentSpeed) {
+            awaitIdle(baseChannel);
+            recordBaseStartRotation();
             
-            if (targetDistance >= 0) {
-                errorBottomLeft = -0.2;
-                errorTopRight, errorBottomRight = 0.2;
-                
-            } else {
-                errorBottomLeft = -0.2;
-                errorTopRight, errorBottomRight = 0.2;
-            }
+            // set up distances. The distance is measured along the target heading from where the robot actually is
+            linearTargetX = x;
+            linearTargetY = y;
+            linearHeading = targetPose.heading;
+            targetPose.x = x;
+            targetPose.y = y;
+            linearTargetDistance = odometry.distanceAlong(linearTargetX, linearTargetY, linearHeading);
             
             /*
             // TEMP
-            std::ostringstream sstream;
-            sstream << targetDistance << " " << absoluteTargetDistance << " " << linearDistanceSoFar;
-            std::string printStatement = sstream.str();
-            runPrint(printStatement);
+            logger.log("%g %g %g", targetDistance, absoluteTargetDistance, linearDistanceSoFar);
             */
             
-            // run until robot travels the given distance
-            while (fabs(absoluteTargetDistance - traveledDistance) >= linearPrecisionThreshold) {
-                
-                /*
-                baseTopLeftMotor.spin(forwardDirection, (absoluteTargetDistance - linearDistanceSoFar) * kpLinear, percentVelocityUnit);
-                baseBottomLeftMotor.spin(forwardDirection, (absoluteTargetDistance - linearDistanceSoFar) * kpLinear, percentVelocityUnit);
-
-                baseTopRightMotor.spin(reverseDirection, (absoluteTargetDistance - linearDistanceSoFar) * kpLinear, percentVelocityUnit);
-                baseBottomRightMotor.spin(reverseDirection, (absoluteTargetDistance - linearDistanceSoFar) * kpLinear, percentVelocityUnit);
-                */
-                
-                // if the difference in target distance and distance so far is positive, go forward; else, go backwards
-                if (absoluteTargetDistance - traveledDistance >= 0) {
-                    
-                    baseTopLeftMotor.spin(forwardDirection, percentSpeed * 100  , percentVelocityUnit);
-                    baseBottomLeftMotor.spin(forwardDirection, percentSpeed * 100 - errorBottomLeft * kpLinear, percentVelocityUnit);
-
-                    baseTopRightMotor.spin(reverseDirection, percentSpeed * 100 + errorTopRight * kpLinear, percentVelocityUnit);
-                    baseBottomRightMotor.spin(reverseDirection, percentSpeed * 100 + errorBottomRight * kpLinear, percentVelocityUnit);
-                    
-                } else {
-                    
-                    baseTopLeftMotor.spin(reverseDirection, percentSpeed * 100  , percentVelocityUnit);
-                    baseBottomLeftMotor.spin(reverseDirection, percentSpeed * 100 - errorBottomLeft * kpLinear, percentVelocityUnit);
-
-                    baseTopRightMotor.spin(forwardDirection, percentSpeed * 100 + errorTopRight * kpLinear, percentVelocityUnit);
-                    baseBottomRightMotor.spin(forwardDirection, percentSpeed * 100 + errorBottomRight * kpLinear, percentVelocityUnit);
-                }
-                
-                // to correct for differing speeds on each wheel, calculate the error of each encoder relative to the top left wheel and adjust speeds accordingly
-                traveledDistance = (baseTopLeftMotor.rotation(degreesUnit)/encoderTicksPerRotation) * wheelCircumference;
-                errorBottomLeft = traveledDistance - (baseBottomLeftMotor.rotation(degreesUnit)/encoderTicksPerRotation) * wheelCircumference;
-                errorTopRight = traveledDistance + (baseTopRightMotor.rotation(degreesUnit)/encoderTicksPerRotation) * wheelCircumference;
-                errorBottomRight = traveledDistance + (baseBottomRightMotor.rotation(degreesUnit)/encoderTicksPerRotation) * wheelCircumference;
+            baseSpeed = percentSpeed;
+            // the direction comes from the sign of the distance; a negative speed would empty the profile and turn the PID clamp inside out
+            linearProfile = TrapezoidalProfile(linearTargetDistance, fabs(percentSpeed) * baseMaxVelocity, linearMaxAcceleration);
+            baseProfileTime = 0;
+            linearPid.reset();
+            linearPid.setOutputLimit(fabs(percentSpeed) * 100);
+            baseSettle.reset();
+            baseSettle.setTolerances(linearPrecisionThreshold, settleVelocity);
+            baseMotion = BASE_LINEAR;
+            baseRecord = routineProfiler.begin("linearMove", linearTargetDistance);
+            baseTrace = trace.begin("linearMove", TRACK_BASE, linearTargetDistance);
+            return MotionHandle(&controlScheduler, &baseChannel, baseChannel.begin());
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: linearMove
+        * Desc: FOR forward / backwards AUTONOMOUS MOVEMENT. Blocking version of linearMoveAsync
+        * Param: 
+        *   - targetDistance for robot to travel by the end of the function in meters. Negative for backwards, Positive for forwards.
+        *   - percentSpeed to be applied to the motors [0.0 - 1.0]
+        * Output: uses baseMove to move robot base
+        */
+        void linearMove(double targetDistance, double percentSpeed) {
+            linearMoveAsync(targetDistance, percentSpeed).await();
+        };
+        void linearMoveTo(double x, double y, double percentSpeed) {
+            linearMoveToAsync(x, y, percentSpeed).await();
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: updateLinearMove
+        * Desc: one control tick of linearMoveAsync. The base follows the trapezoidal profile: the profile velocity is fed forward and the distance PID
+        *       corrects the error to the profile position. The wheel errors keep the four wheels in sync
+        * Param: seconds since the previous tick
+        * Output: returns true once the robot has traveled the given distance and the base has settled
+        */
+        bool updateLinearMove(double dt) {
+            // distance traveled and wheel errors from this tick's sensor snapshot. To correct for differing speeds on each wheel, calculate the error
+            // of each encoder relative to the top left wheel and adjust speeds accordingly
+            traveledDistance = linearTargetDistance - odometry.distanceAlong(linearTargetX, linearTargetY, linearHeading);
+            double topLeftDistance = ((sensors.position[SensorSnapshot::BASE_TOP_LEFT] - baseStartRotation[0])/encoderTicksPerRotation) * wheelCircumference;
+            errorBottomLeft = topLeftDistance - ((sensors.position[SensorSnapshot::BASE_BOTTOM_LEFT] - baseStartRotation[1])/encoderTicksPerRotation) * wheelCircumference;
+            errorTopRight = topLeftDistance + ((sensors.position[SensorSnapshot::BASE_TOP_RIGHT] - baseStartRotation[2])/encoderTicksPerRotation) * wheelCircumference;
+            errorBottomRight = topLeftDistance + ((sensors.position[SensorSnapshot::BASE_BOTTOM_RIGHT] - baseStartRotation[3])/encoderTicksPerRotation) * wheelCircumference;
+            
+            double distanceError = linearTargetDistance - traveledDistance;
+            routineProfiler.overshot(baseRecord, linearTargetDistance >= 0 ? -distanceError : distanceError);
+            
+            // the settle detector watches the whole motion: it finishes once the base has come to rest within the precision threshold, or
+            // holds the base where it got stuck once it has stood still short of the target for the settle timeout
+            if (linearProfile.isFinished(baseProfileTime) && fabs(distanceError) < linearPrecisionThreshold) {
+                routineProfiler.settling(baseRecord);
+            }
+            if (baseSettle.update(distanceError, baseVelocity())) {
+                stopBase();
+                return true;
             }
             
-            baseTopLeftMotor.stop(vex::brakeType::brake);
-            baseTopRightMotor.stop(vex::brakeType::brake);
-            baseBottomLeftMotor.stop(vex::brakeType::brake);
-            baseBottomRightMotor.stop(vex::brakeType::brake);
+            baseProfileTime += dt;
+            ProfileState setpoint = linearProfile.sample(baseProfileTime);
+            double setpointDistance = linearTargetDistance - linearProfile.getDistance() + setpoint.position;
+            
+            double percentSpeed = (baseFeedforward.calculate(setpoint.velocity, setpoint.acceleration) + linearPid.update(setpointDistance - traveledDistance, dt)) / 100;
+            percentSpeed = fmax(-1, fmin(1, percentSpeed));
+            
+            /*
+            baseTopLeftMotor.spin(forwardDirection, (linearTargetDistance - linearDistanceSoFar) * kpLinear, percentVelocityUnit);
+            baseBottomLeftMotor.spin(forwardDirection, (linearTargetDistance - linearDistanceSoFar) * kpLinear, percentVelocityUnit);
+
+            baseTopRightMotor.spin(reverseDirection, (linearTargetDistance - linearDistanceSoFar) * kpLinear, percentVelocityUnit);
+            baseBottomRightMotor.spin(reverseDirection, (linearTargetDistance - linearDistanceSoFar) * kpLinear, percentVelocityUnit);
+            */
             
+            // positive controller output goes forward, negative backwards. The wheel corrections act against the direction of travel
+            double direction = percentSpeed >= 0 ? 1 : -1;
+            baseMotors.setVoltage(SensorSnapshot::BASE_TOP_LEFT, percentSpeed * 100);
+            baseMotors.setVoltage(SensorSnapshot::BASE_BOTTOM_LEFT, percentSpeed * 100 - direction * errorBottomLeft * kpLinear);
+            baseMotors.setVoltage(SensorSnapshot::BASE_TOP_RIGHT, percentSpeed * 100 + direction * errorTopRight * kpLinear);
+            baseMotors.setVoltage(SensorSnapshot::BASE_BOTTOM_RIGHT, percentSpeed * 100 + direction * errorBottomRight * kpLinear);
+            baseMotors.apply();
+            return false;
         };
     
         /* ------------------------------------------------------------------------
@@ -338,22 +1077,21 @@ class Robot {
         * Param: 
         *   - targetDistance for robot to travel by the end of the function in meters. Negative for backwards, Positive for forwards.
         *   - percentSpeed to be applied to the motors [0.0 - 1.0]
-        *   - the VEX Sonar object to detect the distance with
+        *   - the sonar to detect the distance with
         * Output: uses baseMove to move robot base
         */
-        void linearSonarMove(double targetDistance, double percentSpeed, vex::sonar theSonar) {
-            
-            // all sonar distances are multiplied by 100 since the sonar.distance() function returns millimeters
-            
-            baseTopLeftMotor.resetRotation();
-            baseBottomLeftMotor.resetRotation();
-            baseTopRightMotor.resetRotation();
-            baseBottomRightMotor.resetRotation();
+        void linearSonarMove(double targetDistance, double percentSpeed, SensorSnapshot::Sonar theSonar) {
+            awaitIdle(baseChannel);
+            int record = routineProfiler.begin("linearSonarMove", targetDistance);
+            TraceScope scope(trace, "linearSonarMove", TRACK_BASE, targetDistance);
+            foregroundPrimitive = TelemetryRecorder::PRIMITIVE_LINEAR_SONAR_MOVE;
             
             // set up distances
-            sonarDistance = theSonar.distance(millimeterUnits) / 1000;
+            sonarDistance = sensors.sonar[theSonar];
             
-            errorBottomLeft, errorBottomRight, errorTopRight = 0;
+            errorBottomLeft = 0;
+            errorBottomRight = 0;
+            errorTopRight = 0;
             
             // run until robot travels the given distance
             while (fabs(targetDistance - sonarDistance) >= linearSonarPrecisionThreshold) {
@@ -361,117 +1099,344 @@ class Robot {
                 // if the difference in target distance and distance so far is negative, go forward; else, go backwards 
                 // (flipped because the sonar value decreases as the robot gets closer to the target)
                 
-                if (targetDistance - sonarDistance <= 0) {
-                    
-                    baseTopLeftMotor.spin(reverseDirection, percentSpeed * 100  , percentVelocityUnit);
-                    baseBottomLeftMotor.spin(reverseDirection, percentSpeed * 100 - errorBottomLeft * kpLinear, percentVelocityUnit);
-
-                    baseTopRightMotor.spin(forwardDirection, percentSpeed * 100 + errorTopRight * kpLinear, percentVelocityUnit);
-                    baseBottomRightMotor.spin(forwardDirection, percentSpeed * 100 + errorBottomRight * kpLinear, percentVelocityUnit);
-                    
-                } else {
-                    
-                    baseTopLeftMotor.spin(forwardDirection, percentSpeed * 100  , percentVelocityUnit);
-                    baseBottomLeftMotor.spin(forwardDirection, percentSpeed * 100 - errorBottomLeft * kpLinear, percentVelocityUnit);
-
-                    baseTopRightMotor.spin(reverseDirection, percentSpeed * 100 + errorTopRight * kpLinear, percentVelocityUnit);
-                    baseBottomRightMotor.spin(reverseDirection, percentSpeed * 100 + errorBottomRight * kpLinear, percentVelocityUnit);
-                }
+                double direction = targetDistance - sonarDistance <= 0 ? -1 : 1;
+                baseMotors.setVelocity(SensorSnapshot::BASE_TOP_LEFT, direction * percentSpeed * 100);
+                baseMotors.setVelocity(SensorSnapshot::BASE_BOTTOM_LEFT, direction * (percentSpeed * 100 - errorBottomLeft * kpLinear));
+                baseMotors.setVelocity(SensorSnapshot::BASE_TOP_RIGHT, direction * (percentSpeed * 100 + errorTopRight * kpLinear));
+                baseMotors.setVelocity(SensorSnapshot::BASE_BOTTOM_RIGHT, direction * (percentSpeed * 100 + errorBottomRight * kpLinear));
+                baseMotors.apply();
                 // to correct for differing speeds on each wheel, calculate the error of each encoder relative to the top left wheel and adjust speeds accordingly
-                sonarDistance = theSonar.distance(millimeterUnits) / 1000;
                 /*
                 errorBottomLeft = traveledDistance - (baseBottomLeftMotor.rotation(degreesUnit)/encoderTicksPerRotation) * wheelCircumference;
                 errorTopRight = traveledDistance + (baseTopRightMotor.rotation(degreesUnit)/encoderTicksPerRotation) * wheelCircumference;
                 errorBottomRight = traveledDistance + (baseBottomRightMotor.rotation(degreesUnit)/encoderTicksPerRotation) * wheelCircumference;*/
                 
-                // TEMP
-                std::ostringstream sstream;
-                sstream << sonarDistance;
-                std::string printStatement = sstream.str();
-                runPrint(printStatement);
-                
+                controlScheduler.waitForNextTick();
+                sonarDistance = sensors.sonar[theSonar];
             }
             
-            baseTopLeftMotor.stop(vex::brakeType::brake);
-            baseTopRightMotor.stop(vex::brakeType::brake);
-            baseBottomLeftMotor.stop(vex::brakeType::brake);
-            baseBottomRightMotor.stop(vex::brakeType::brake);
+            baseMotors.stopAll(vex::brakeType::brake);
+            baseMotors.apply();
             
+            // the sonar decides where the robot stops, so the next motion starts from where the robot actually is
+            targetPose.x = odometry.getPose().x;
+            targetPose.y = odometry.getPose().y;
+            foregroundPrimitive = TelemetryRecorder::PRIMITIVE_NONE;
+            routineProfiler.end(record);
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: rotationalMoveAsync
+        * Desc: FOR rotating in place / turning a radius AUTONOMOUS MOVEMENT. Uses PID. Starts the movement and returns right away; the movement runs
+        *       on the control scheduler ticks. Waits for any base movement that is still running first
+        * Param: 
+        *   - radius for robot follow in meters.
+        *       * 0 to turn in place. Greater than 0 to turn a radius, driving forwards around a center on the side the robot turns towards
+        *   - targetAngle for robot to travel by the end of the function in degrees. Positive for clockwise, negative for counter clockwise
+        *   - percentSpeed to be applied to the motors [0.0 - 1.0]. The sign of targetAngle sets the direction, the sign of percentSpeed is ignored
+        * Output: MotionHandle to await or poll the movement
+        */
+        MotionHandle rotationalMoveAsync(double radius, double targetAngle, double percentSpeed) {
+            awaitIdle(baseChannel);
+            if (radius <= 0) {
+                return rotationalMoveToAsync(targetPose.heading + targetAngle, percentSpeed);
+            }
+            
+            // nothing to turn: both arcs and the profile would be empty
+            if (targetAngle == 0) {
+                unsigned int sequence = baseChannel.begin();
+                baseChannel.finish();
+                return MotionHandle(&controlScheduler, &baseChannel, sequence);
+            }
+            
+            // each side drives an arc around the turn center: the outer side at radius + half the track width, the inner side at radius - half the track width
+            double radians = targetAngle * M_PI / 180;
+            arcLeftLength = (radius + trackWidth / 2) * radians;
+            arcRightLength = (radius - trackWidth / 2) * radians;
+            if (targetAngle < 0) {
+                arcLeftLength = -(radius - trackWidth / 2) * radians;
+                arcRightLength = -(radius + trackWidth / 2) * radians;
+            }
+            arcLeftStart = odometry.getLeftDistance();
+            arcRightStart = odometry.getRightDistance();
+            
+            // the end of the turn in field coordinates: the turn center is radius to the side of the target pose
+            double side = (targetAngle >= 0) ? 1 : -1;
+            double startHeading = targetPose.heading * M_PI / 180;
+            double endHeading = startHeading + radians;
+            double centerX = targetPose.x - side * radius * sin(startHeading);
+            double centerY = targetPose.y + side * radius * cos(startHeading);
+            targetPose.x = centerX + side * radius * sin(endHeading);
+            targetPose.y = centerY - side * radius * cos(endHeading);
+            targetPose.heading = targetPose.heading + targetAngle;
+            
+            // profile the outer side, which drives the longest arc, at the requested speed; the inner side follows in proportion
+            baseSpeed = percentSpeed;
+            arcProfile = TrapezoidalProfile(fmax(fabs(arcLeftLength), fabs(arcRightLength)), fabs(percentSpeed) * baseMaxVelocity, linearMaxAcceleration);
+            baseProfileTime = 0;
+            leftArcPid.reset();
+            rightArcPid.reset();
+            leftArcPid.setOutputLimit(100);
+            rightArcPid.setOutputLimit(100);
+            baseSettle.reset();
+            baseSettle.setTolerances(linearPrecisionThreshold, settleVelocity);
+            baseMotion = BASE_ARC;
+            baseRecord = routineProfiler.begin("radiusTurn", targetAngle);
+            baseTrace = trace.begin("radiusTurn", TRACK_BASE, targetAngle);
+            return MotionHandle(&controlScheduler, &baseChannel, baseChannel.begin());
+        };
+        MotionHandle rotationalMoveAsync(double targetAngle, double percentSpeed) {
+            return rotationalMoveAsync(0, targetAngle, percentSpeed);
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: rotationalMoveToAsync
+        * Desc: FOR rotating in place to a field heading AUTONOMOUS MOVEMENT. Turns by whatever angle is left between the robot's actual heading and the target,
+        *       so errors of earlier turns do not add up. Starts the movement and returns right away; the movement runs on the control scheduler ticks.
+        *       Waits for any base movement that is still running first
+        * Param: 
+        *   - targetHeading in degrees clockwise from the starting heading (see Pose). Not wrapped: 360 is a full turn from 0
+        *   - percentSpeed to be applied to the motors [0.0 - 1.0]. The sign of the angle left to turn sets the direction
+        * Output: MotionHandle to await or poll the movement
+        */
+        MotionHandle rotationalMoveToAsync(double targetHeading, double percentSpeed) {
+            awaitIdle(baseChannel);
+            startRotationalMove(targetHeading, percentSpeed);
+            baseRecord = routineProfiler.begin("rotationalMove", targetHeading - rotationalStartHeading);
+            baseTrace = trace.begin("rotationalMove", TRACK_BASE, targetHeading - rotationalStartHeading);
+            return MotionHandle(&controlScheduler, &baseChannel, baseChannel.begin());
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: startRotationalMove
+        * Desc: sets up the profile and controllers of a rotation to a field heading and hands the base to updateRotationalMove. Used by rotationalMoveToAsync
+        *       and by a path motion turning to its final heading
+        * Param: 
+        *   - targetHeading in degrees (see Pose)
+        *   - percentSpeed to be applied to the motors [0.0 - 1.0]. The sign of the angle left to turn sets the direction
+        * Output: none
+        */
+        void startRotationalMove(double targetHeading, double percentSpeed) {
+            recordBaseStartRotation();
+            
+            rotationalStartHeading = odometry.getPose().heading;
+            targetPose.heading = targetHeading;
+            double startingAngle = 0;
+            double targetAngle = targetHeading - rotationalStartHeading;
+            
+            // convert the angle left to turn in degrees to encoder ticks. The angles of a rotational motion are measured in encoder ticks from its start
+            absoluteTargetAngle = targetAngle * encoderTicksPerDegree + startingAngle; 
+
+            baseSpeed = percentSpeed;
+            // the direction comes from the sign of the angle; a negative speed would empty the profile and turn the PID clamp inside out
+            rotationalProfile = TrapezoidalProfile(absoluteTargetAngle - startingAngle, fabs(percentSpeed) * baseMaxRotationalVelocity, rotationalMaxAcceleration);
+            baseProfileTime = 0;
+            rotationalPid.reset();
+            rotationalPid.setOutputLimit(fabs(percentSpeed) * 100);
+            baseSettle.reset();
+            baseSettle.setTolerances(rotationalPrecisionThreshold, settleVelocity);
+            baseMotion = BASE_ROTATIONAL;
         };
         
         /* ------------------------------------------------------------------------
         * Function: rotationalMove
-        * Desc: FOR rotating in place / turning a radius AUTONOMOUS MOVEMENT. Uses PID
+        * Desc: FOR rotating in place / turning a radius AUTONOMOUS MOVEMENT. Blocking version of rotationalMoveAsync
         * Param: 
-        *   - radius for robot follow in meters. // YET TO BE IMPLEMENTED
-        *       * 0 to turn in place. Greater than 0 to turn a radius
-        *   - targetAngle for robot to travel by the end of the function in degrees. 0 - infinity
-        *   - percentSpeed to be applied to the motors ( negative for counter clockwise, positive for clockwise )
+        *   - radius for robot follow in meters. 0 (or left out) to turn in place
+        *   - targetAngle for robot to travel by the end of the function in degrees. Positive for clockwise, negative for counter clockwise
+        *   - percentSpeed to be applied to the motors [0.0 - 1.0]. The sign of targetAngle sets the direction, the sign of percentSpeed is ignored
         * Output: uses baseMove to move robot base
         */
-        void rotationalMove(/*double radius,*/ double targetAngle, double percentSpeed) {
+        void rotationalMove(double radius, double targetAngle, double percentSpeed) {
+            rotationalMoveAsync(radius, targetAngle, percentSpeed).await();
+        };
+        void rotationalMove(double targetAngle, double percentSpeed) {
+            rotationalMoveAsync(0, targetAngle, percentSpeed).await();
+        };
+        void rotationalMoveTo(double targetHeading, double percentSpeed) {
+            rotationalMoveToAsync(targetHeading, percentSpeed).await();
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: updateRotationalMove
+        * Desc: one control tick of rotationalMoveAsync. The base follows the trapezoidal profile: the profile velocity is fed forward and the angle PID
+        *       corrects the error to the profile angle. The wheel errors keep the four wheels in sync
+        * Param: seconds since the previous tick
+        * Output: returns true once the robot has pivoted to the given angle and the base has settled
+        */
+        bool updateRotationalMove(double dt) {
+            // angle turned and wheel errors from this tick's sensor snapshot. To correct for differing speeds on each wheel, calculate the error
+            // of each encoder relative to the top left wheel and adjust speeds accordingly
+            traveledAngle = (odometry.getPose().heading - rotationalStartHeading) * encoderTicksPerDegree;
+            double topLeftAngle = sensors.position[SensorSnapshot::BASE_TOP_LEFT] - baseStartRotation[0];
+            errorBottomLeft = topLeftAngle - (sensors.position[SensorSnapshot::BASE_BOTTOM_LEFT] - baseStartRotation[1]);
+            errorTopRight = topLeftAngle - (sensors.position[SensorSnapshot::BASE_TOP_RIGHT] - baseStartRotation[2]);
+            errorBottomRight = topLeftAngle - (sensors.position[SensorSnapshot::BASE_BOTTOM_RIGHT] - baseStartRotation[3]);
+            
+            double angleError = absoluteTargetAngle - traveledAngle;
+            routineProfiler.overshot(baseRecord, rotationalProfile.getDistance() >= 0 ? -angleError : angleError);
             
-            baseTopLeftMotor.resetRotation();
-            baseBottomLeftMotor.resetRotation();
-            baseTopRightMotor.resetRotation();
-            baseBottomRightMotor.resetRotation();
+            // the settle detector watches the whole motion: it finishes once the base has come to rest within the precision threshold, or
+            // holds the base where it got stuck once it has stood still short of the target for the settle timeout
+            if (rotationalProfile.isFinished(baseProfileTime) && fabs(angleError) < rotationalPrecisionThreshold) {
+                routineProfiler.settling(baseRecord);
+            }
+            if (baseSettle.update(angleError, baseVelocity())) {
+                stopBase();
+                return true;
+            }
             
-            double startingAngle = baseTopLeftMotor.rotation(degreesUnit);
-            traveledAngle = startingAngle;
+            baseProfileTime += dt;
+            ProfileState setpoint = rotationalProfile.sample(baseProfileTime);
+            double setpointAngle = absoluteTargetAngle - rotationalProfile.getDistance() + setpoint.position;
             
-            // convert targetAngle in degrees to targetAngle in encoder ticks. Add startingAngle to obtain absolute targetAngle in encoder values
-            // 8.4667 encoder ticks in one rotation in place (number obtained experimentally)
-            absoluteTargetAngle = targetAngle * 7.678056 + startingAngle; 
+            // the profile is in encoder degrees; the feedforward works on the wheel surface speed
+            double wheelVelocity = setpoint.velocity / encoderTicksPerRotation * wheelCircumference;
+            double wheelAcceleration = setpoint.acceleration / encoderTicksPerRotation * wheelCircumference;
+            double percentSpeed = (baseFeedforward.calculate(wheelVelocity, wheelAcceleration) + rotationalPid.update(setpointAngle - traveledAngle, dt)) / 100;
+            percentSpeed = fmax(-1, fmin(1, percentSpeed));
             
-            // initiate error values greater than 0 to correct for initial drift
-            if (targetAngle >= 0) {
-                errorBottomLeft, errorTopRight, errorBottomRight = 0.2;
-            } else {
-                errorBottomLeft, errorTopRight, errorBottomRight = -0.2;
+            /*
+            // TEMP
+            runPrint(fabs(absoluteTargetAngle - rotationalAngleSoFar));
+            */
+            
+            // if the controller output is positive, spin counter clockwise. if negative, spin clockwise
+            // (the right side drives backwards to spin, so its outputs are negated)
+            baseMotors.setVoltage(SensorSnapshot::BASE_TOP_LEFT, percentSpeed * 100);
+            baseMotors.setVoltage(SensorSnapshot::BASE_BOTTOM_LEFT, percentSpeed * 100 + errorBottomLeft * kpRotational);
+            baseMotors.setVoltage(SensorSnapshot::BASE_TOP_RIGHT, -(percentSpeed * 100 + errorTopRight * kpRotational));
+            baseMotors.setVoltage(SensorSnapshot::BASE_BOTTOM_RIGHT, -(percentSpeed * 100 + errorBottomRight * kpRotational));
+            baseMotors.apply();
+            return false;
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: updateRadiusTurn
+        * Desc: one control tick of a radius turn started by rotationalMoveAsync. Each side follows its share of the outer side's trapezoidal profile:
+        *       the profile velocity is fed forward and the side's arc length PID corrects the error to its setpoint
+        * Param: seconds since the previous tick
+        * Output: returns true once both sides have driven their arcs and the base has settled
+        */
+        bool updateRadiusTurn(double dt) {
+            double leftTravel = odometry.getLeftDistance() - arcLeftStart;
+            double rightTravel = odometry.getRightDistance() - arcRightStart;
+            double arcError = fmax(fabs(arcLeftLength - leftTravel), fabs(arcRightLength - rightTravel));
+            
+            // the settle detector watches the whole motion: it finishes once the base has come to rest within the precision threshold, or
+            // holds the base where it got stuck once it has stood still short of the target for the settle timeout
+            if (arcProfile.isFinished(baseProfileTime) && arcError < linearPrecisionThreshold) {
+                routineProfiler.settling(baseRecord);
             }
-
-            // rotate until robot pivots to the given angle
-            while (fabs(absoluteTargetAngle - traveledAngle) >= rotationalPrecisionThreshold) {
-                
-                /*
-                // TEMP
-                std::ostringstream sstream;
-                sstream << fabs(absoluteTargetAngle - rotationalAngleSoFar);
-                std::string printStatement = sstream.str();
-                runPrint(printStatement);
-                */
-                
-                // if target is positive, spin counter clockwise. if negative, spin clockwise
-                if (absoluteTargetAngle - traveledAngle > rotationalPrecisionThreshold) {
-                    
-                    baseTopLeftMotor.spin(forwardDirection, percentSpeed * 100, percentVelocityUnit);
-                    baseBottomLeftMotor.spin(forwardDirection, percentSpeed * 100 + errorBottomLeft * kpRotational, percentVelocityUnit);
-
-                    baseTopRightMotor.spin(forwardDirection, percentSpeed * 100 + errorTopRight * kpRotational, percentVelocityUnit);
-                    baseBottomRightMotor.spin(forwardDirection, percentSpeed * 100 + errorBottomRight * kpRotational, percentVelocityUnit);
-                    
-                } else if (absoluteTargetAngle - traveledAngle < rotationalPrecisionThreshold) {
-                    
-                    baseTopLeftMotor.spin(reverseDirection, percentSpeed * 100, percentVelocityUnit);
-                    baseBottomLeftMotor.spin(reverseDirection, percentSpeed * 100 - errorBottomLeft * kpRotational, percentVelocityUnit);
-
-                    baseTopRightMotor.spin(reverseDirection, percentSpeed * 100 - errorTopRight * kpRotational, percentVelocityUnit);
-                    baseBottomRightMotor.spin(reverseDirection, percentSpeed * 100 - errorBottomRight * kpRotational, percentVelocityUnit);
-                    
-                }
-                
-                // to correct for differing speeds on each wheel, calculate the error of each encoder relative to the top left wheel and adjust speeds accordingly
-                traveledAngle = baseTopLeftMotor.rotation(degreesUnit);
-                errorBottomLeft = traveledAngle - baseBottomLeftMotor.rotation(degreesUnit);
-                errorTopRight = traveledAngle - baseTopRightMotor.rotation(degreesUnit);
-                errorBottomRight = traveledAngle - baseBottomRightMotor.rotation(degreesUnit);
+            if (baseSettle.update(arcError, baseVelocity())) {
+                stopBase();
+                return true;
+            }
+            
+            baseProfileTime += dt;
+            ProfileState setpoint = arcProfile.sample(baseProfileTime);
+            double leftRatio = arcLeftLength / arcProfile.getDistance();
+            double rightRatio = arcRightLength / arcProfile.getDistance();
+            
+            double leftPercent = baseFeedforward.calculate(setpoint.velocity * leftRatio, setpoint.acceleration * leftRatio) + leftArcPid.update(setpoint.position * leftRatio - leftTravel, dt);
+            double rightPercent = baseFeedforward.calculate(setpoint.velocity * rightRatio, setpoint.acceleration * rightRatio) + rightArcPid.update(setpoint.position * rightRatio - rightTravel, dt);
+            leftPercent = fmax(-100, fmin(100, leftPercent));
+            rightPercent = fmax(-100, fmin(100, rightPercent));
+            
+            baseVoltageMove(leftPercent, rightPercent);
+            return false;
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: followPathAsync
+        * Desc: FOR driving a curved AUTONOMOUS path. Follows the waypoints with pure pursuit without stopping at any of them, then turns in place to the
+        *       final heading. The path and the turn are profiled and traced as two steps. Starts the movement and returns right away; the movement runs
+        *       on the control scheduler ticks. Waits for any base movement that is still running first
+        * Param: 
+        *   - waypoints to drive through in field coordinates (see Pose). Driven forwards
+        *   - number of waypoints (at most PurePursuit::maxWaypoints)
+        *   - finalHeading for the robot to face at the end of the path in degrees (see Pose)
+        *   - percentSpeed to be applied to the motors [0.0 - 1.0]
+        * Output: MotionHandle to await or poll the movement
+        */
+        MotionHandle followPathAsync(const Waypoint *path, int count, double finalHeading, double percentSpeed) {
+            awaitIdle(baseChannel);
+            
+            pathFollower.setPath(odometry.getPose(), path, count);
+            pathFinalHeading = finalHeading;
+            pathSpeed = percentSpeed;
+            pathVelocity = 0;
+            baseSpeed = percentSpeed;
+            targetPose.x = pathFollower.endPoint().x;
+            targetPose.y = pathFollower.endPoint().y;
+            baseSettle.reset();
+            baseSettle.setTolerances(pathEndTolerance, settleVelocity);
+            baseMotion = BASE_PATH;
+            baseRecord = routineProfiler.begin("followPath", pathFollower.remainingDistance(odometry.getPose()));
+            baseTrace = trace.begin("followPath", TRACK_BASE, pathFollower.remainingDistance(odometry.getPose()));
+            return MotionHandle(&controlScheduler, &baseChannel, baseChannel.begin());
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: followPath
+        * Desc: FOR driving a curved AUTONOMOUS path. Blocking version of followPathAsync
+        * Param: 
+        *   - waypoints to drive through in field coordinates (see Pose). Driven forwards
+        *   - number of waypoints (at most PurePursuit::maxWaypoints)
+        *   - finalHeading for the robot to face at the end of the path in degrees (see Pose)
+        *   - percentSpeed to be applied to the motors [0.0 - 1.0]
+        * Output: uses baseMove to move robot base
+        */
+        void followPath(const Waypoint *path, int count, double finalHeading, double percentSpeed) {
+            followPathAsync(path, count, finalHeading, percentSpeed).await();
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: updateFollowPath
+        * Desc: one control tick of followPathAsync. The speed ramps up and down at linearMaxAcceleration so the robot reaches the last waypoint at rest,
+        *       and the left and right wheels are split to drive the pure pursuit arc
+        * Param: seconds since the previous tick
+        * Output: returns false; once the last waypoint is reached, or the base got stuck on the way, the base motion becomes the turn to the final
+        *         heading, which finishes the motion
+        */
+        bool updateFollowPath(double dt) {
+            const Pose &pose = odometry.getPose();
+            
+            // the settle detector watches the path like a linear motion, so a base stuck on a wall or a cube short of the last waypoint
+            // gives up on the path after the settle timeout instead of pushing until field control ends the routine
+            bool stuck = baseSettle.update(pathFollower.remainingDistance(pose), baseVelocity());
+            if (pathFollower.isFinished(pose, pathEndTolerance) || stuck) {
+                baseMove(0, 0);
+                routineProfiler.end(baseRecord);
+                trace.end(baseTrace);
                 
+                startRotationalMove(pathFinalHeading, pathSpeed);
+                baseRecord = routineProfiler.begin("rotationalMove", pathFinalHeading - rotationalStartHeading);
+                baseTrace = trace.begin("rotationalMove", TRACK_BASE, pathFinalHeading - rotationalStartHeading);
+                return false;
+            }
+            
+            double curvature = pathFollower.update(pose);
+            
+            // accelerate from the current speed, and slow down early enough to stop at the last waypoint
+            double velocity = fmin(pathSpeed * baseMaxVelocity, pathVelocity + linearMaxAcceleration * dt);
+            velocity = fmin(velocity, sqrt(2 * linearMaxAcceleration * pathFollower.remainingDistance(pose)));
+            double acceleration = (dt > 0) ? (velocity - pathVelocity) / dt : 0;
+            pathVelocity = velocity;
+            
+            // left and right wheel speeds of the arc, scaled down together if the outer wheel would go past full speed
+            double leftScale = 1 + curvature * trackWidth / 2;
+            double rightScale = 1 - curvature * trackWidth / 2;
+            double leftPercent = baseFeedforward.calculate(velocity * leftScale, acceleration * leftScale);
+            double rightPercent = baseFeedforward.calculate(velocity * rightScale, acceleration * rightScale);
+            double fastest = fmax(fabs(leftPercent), fabs(rightPercent));
+            if (fastest > 100) {
+                leftPercent = leftPercent * 100 / fastest;
+                rightPercent = rightPercent * 100 / fastest;
             }
             
-            baseTopLeftMotor.stop(vex::brakeType::brake);
-            baseTopRightMotor.stop(vex::brakeType::brake);
-            baseBottomLeftMotor.stop(vex::brakeType::brake);
-            baseBottomRightMotor.stop(vex::brakeType::brake);
+            baseVoltageMove(leftPercent, rightPercent);
+            return false;
         };
     
         /* ------------------------------------------------------------------------
@@ -484,82 +1449,124 @@ class Robot {
         */
         void armPivot(bool upOrDown, double percentSpeed) {
             // update armPivot angle
-            armPivotCurrentAngle = armPivotMotor.rotation(degreesUnit);
+            armPivotCurrentAngle = sensors.position[SensorSnapshot::ARM_PIVOT];
             
             // hold arm steady if function argument speed is 0 
             if (percentSpeed == 0) {
                 armPivotMotor.stop(vex::brakeType::hold);
+                armPid.reset();
             }
             // else if armPivot position is at the maximum or minimums, only allow movement in the opposite direction
             else if (armPivotCurrentAngle >= armPivotUpperAngle) {
                 if (upOrDown) {
-                    runPrint("a");
                     armPivotMotor.stop(vex::brakeType::hold);
                 } else {
-                    runPrint("b");
                     armPivotMotor.spin(reverseDirection, percentSpeed * 100, percentVelocityUnit);
                 }
             }
             else if (armPivotCurrentAngle <= armPivotLowerAngle) {
                 
                 if (upOrDown) {
-                    runPrint("c");
                     armPivotMotor.spin(forwardDirection, percentSpeed * 100, percentVelocityUnit);
                 } else {
-                    runPrint("d");
                     armPivotMotor.stop(vex::brakeType::hold);
                 }
             }
             else {
                 if (upOrDown) {
-                    runPrint("e");
                     armPivotMotor.spin(forwardDirection, percentSpeed * 100, percentVelocityUnit);
                 } else {
-                    runPrint("f");
                     armPivotMotor.spin(reverseDirection, percentSpeed * 100, percentVelocityUnit);
                 }
             }
         };
     
         /* ------------------------------------------------------------------------
-        * Function: armPivotUntilPercent (version of rampLift function with while loop)
-        * Desc: pivot arm until given percentage of the arm movement range
+        * Function: armPivotUntilPercentAsync (version of rampLift function with while loop)
+        * Desc: pivot arm until given percentage of the arm movement range. Starts the movement and returns right away; the movement runs on the
+        *       control scheduler ticks. Waits for any arm movement that is still running first
         * Param:
         *   -percent between [0, 1] of the arm movement range
         *   -speed to apply to motors in percent of motor speed ranging [0, 1]
-        * Output: moves arm up and down
+        * Output: MotionHandle to await or poll the movement
         */
-        void armPivotUntilPercent(double untilPercentage, double percentSpeed) {
+        MotionHandle armPivotUntilPercentAsync(double untilPercentage, double percentSpeed) {
+            awaitIdle(armChannel);
+            
             // calculate and update current and target angles
-            double currentAngle = armPivotMotor.rotation(degreesUnit);
+            double currentAngle = sensors.position[SensorSnapshot::ARM_PIVOT];
             double targetAngle = untilPercentage * (armPivotUpperAngle - armPivotLowerAngle);
+            unsigned int sequence = armChannel.begin();
+            armRecord = routineProfiler.begin("armPivot", untilPercentage);
+            armTrace = trace.begin("armPivot", TRACK_ARM, untilPercentage);
             
             // Hold arm still if argument speed is 0 or if target angle is the same as the current angle
             if (percentSpeed == 0 || currentAngle == targetAngle) {
                 armPivotMotor.stop(vex::brakeType::hold);
+                armChannel.finish();
+                routineProfiler.end(armRecord);
+                trace.end(armTrace);
                 
             } else {
-                bool upOrDown = (currentAngle <= targetAngle) ? true : false; // if current angle less than target, set boolean to "go up"
-                    
-                if (upOrDown) {
-                    while(currentAngle < targetAngle) {
-                        currentAngle = armPivotMotor.rotation(degreesUnit);
-                        armPivotMotor.spin(forwardDirection, percentSpeed * 100, percentVelocityUnit);
-                    }                    
-                    armPivotMotor.stop(vex::brakeType::hold);
-                } else {
-                    while(currentAngle > targetAngle) {
-                        currentAngle = armPivotMotor.rotation(degreesUnit);
-                        armPivotMotor.spin(reverseDirection, percentSpeed * 100, percentVelocityUnit);
-                    }
-                    armPivotMotor.stop(vex::brakeType::hold);
-                }
+                armTargetAngle = targetAngle;
+                armSpeed = percentSpeed;
+                // the direction comes from the sign of the angle left to pivot; a negative speed would empty the profile and turn the PID clamp inside out
+                armProfile = SCurveProfile(targetAngle - currentAngle, fabs(percentSpeed) * liftMaxVelocity, armMaxAcceleration, armMaxJerk);
+                armProfileTime = 0;
+                armPid.reset();
+                armPid.setOutputLimit(fabs(percentSpeed) * 100);
+                armSettle.reset();
+                armMotion = true;
+            }
+            return MotionHandle(&controlScheduler, &armChannel, sequence);
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: armPivotUntilPercent
+        * Desc: pivot arm until given percentage of the arm movement range. Blocking version of armPivotUntilPercentAsync
+        * Param:
+        *   -percent between [0, 1] of the arm movement range
+        *   -speed to apply to motors in percent of motor speed ranging [0, 1]
+        * Output: moves arm up and down
+        */
+        void armPivotUntilPercent(double untilPercentage, double percentSpeed) {
+            armPivotUntilPercentAsync(untilPercentage, percentSpeed).await();
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: updateArmPivotUntilPercent
+        * Desc: one control tick of armPivotUntilPercentAsync. The arm follows the S-curve profile: the profile velocity is fed forward and the
+        *       arm PID corrects the error to the profile angle
+        * Param: seconds since the previous tick
+        * Output: returns true once the arm has reached the target angle and has settled, then holds it
+        */
+        bool updateArmPivotUntilPercent(double dt) {
+            double currentAngle = sensors.position[SensorSnapshot::ARM_PIVOT];
+            double angleError = armTargetAngle - currentAngle;
+            routineProfiler.overshot(armRecord, armProfile.getDistance() >= 0 ? -angleError : angleError);
+            
+            // the settle detector watches the whole motion: it finishes once the arm has come to rest within the threshold, or once a cube or
+            // the stack has held it short of the target for the settle timeout
+            if (armProfile.isFinished(armProfileTime) && fabs(angleError) < armPivotThreshold) {
+                routineProfiler.settling(armRecord);
+            }
+            if (armSettle.update(angleError, sensors.velocity[SensorSnapshot::ARM_PIVOT])) {
+                armPivotMotor.stop(vex::brakeType::hold);
+                return true;
             }
+            
+            armProfileTime += dt;
+            ProfileState setpoint = armProfile.sample(armProfileTime);
+            double setpointAngle = armTargetAngle - armProfile.getDistance() + setpoint.position;
+            
+            double percentSpeed = setpoint.velocity / liftMaxVelocity * 100 + armPid.update(setpointAngle - currentAngle, dt);
+            armPivotMotor.spin(forwardDirection, fmax(-100, fmin(100, percentSpeed)), percentVelocityUnit);
+            return false;
         };
 
         /* ------------------------------------------------------------------------
         * Function: armPivotToPercent (version of rampLift function with ifs)
-        * Desc: pivot arm to given percentage of the arm movement range
+        * Desc: pivot arm to given percentage of the arm movement range with the arm PID. Called once per driver control tick
         * Param:
         *   -percent between [0, 1] of the arm movement range
         *   -speed to apply to motors in percent of motor speed ranging [0, 1]
@@ -569,49 +1576,17 @@ class Robot {
             // calculate and update current and target angles
             double targetAngle = toPercentage * (armPivotUpperAngle - armPivotLowerAngle);
 
-            armPivotCurrentAngle = armPivotMotor.rotation(degreesUnit);
+            armPivotCurrentAngle = sensors.position[SensorSnapshot::ARM_PIVOT];
             
             // Hold arm still if argument speed is 0 or if target angle is near the current angle
             if (percentSpeed == 0 || fabs(armPivotCurrentAngle - targetAngle) <= armPivotThreshold) {
                 armPivotMotor.stop(vex::brakeType::hold);
+                armPid.reset();
                 
             } else {
-                // if target is above, set to Up, if target is below, set to Below
-                bool upOrDown;
-                if (armPivotCurrentAngle <= targetAngle) {
-                  upOrDown = true;
-                } else {
-                  upOrDown = false;
-                }
-                
-                if (armPivotCurrentAngle >= targetAngle) {
-                    if (upOrDown) {
-                        //runPrint("a");
-                        armPivotMotor.stop(vex::brakeType::hold);
-                    } else {
-                        //runPrint("b");
-                        armPivotMotor.spin(reverseDirection, percentSpeed * 100, percentVelocityUnit);
-                    }
-                }
-                else if (armPivotCurrentAngle <= armPivotLowerAngle) {
-                    
-                    if (upOrDown) {
-                        //runPrint("c");
-                        armPivotMotor.spin(forwardDirection, percentSpeed * 100, percentVelocityUnit);
-                    } else {
-                        //runPrint("d");
-                        armPivotMotor.stop(vex::brakeType::hold);
-                    }
-                }
-                else {
-                    if (upOrDown) {
-                        //runPrint("e");
-                        armPivotMotor.spin(forwardDirection, percentSpeed * 100, percentVelocityUnit);
-                    } else {
-                        //runPrint("f");
-                        armPivotMotor.spin(reverseDirection, percentSpeed * 100, percentVelocityUnit);
-                    }
-                }
+                // the PID output is signed: positive pivots up, negative pivots down
+                armPid.setOutputLimit(fabs(percentSpeed) * 100);
+                armPivotMotor.spin(forwardDirection, armPid.update(targetAngle - armPivotCurrentAngle, controlScheduler.lastTickInterval()), percentVelocityUnit);
             }
         };
     
@@ -679,7 +1654,7 @@ class Robot {
         */
         void rampLift(bool forwardOrBack, double percentSpeed) {
             // update ramp lift angle
-            rampLiftCurrentAngle = rampLiftMotor.rotation(degreesUnit);
+            rampLiftCurrentAngle = sensors.position[SensorSnapshot::RAMP_LIFT];
             
             //calculate ramp lift speed
             rampLiftSpeed = percentSpeed * 100; //(1000/(percentSpeed * 100 + 1)) + 5;
@@ -693,31 +1668,25 @@ class Robot {
                 if (!forwardOrBack) {
                     // lift up
                     rampLiftMotor.spin(reverseDirection, rampLiftSpeed, percentVelocityUnit);
-                    runPrint("a");
                 } else {
                     rampLiftMotor.stop(vex::brakeType::hold);
-                    runPrint("b");
                 }
             }
             else if (rampLiftCurrentAngle <= rampLiftLowerAngle) {
                 if (forwardOrBack) {
                     // move back
                     rampLiftMotor.spin(forwardDirection, percentSpeed * 100, percentVelocityUnit);
-                    runPrint("c");
                 } else {
                     rampLiftMotor.stop(vex::brakeType::hold);
-                    runPrint("d");
                 }
             }
             else {
                 if (forwardOrBack) {
                     //lift up
                     rampLiftMotor.spin(forwardDirection, rampLiftSpeed, percentVelocityUnit);
-                    runPrint("e");
                 } else {
                     //move back
                     rampLiftMotor.spin(reverseDirection, percentSpeed * 100, percentVelocityUnit);
-                    runPrint("f");
                 }
             }
         };
@@ -732,7 +1701,7 @@ class Robot {
         */
         void rampLiftByVelocity (bool forwardOrBack) {
             // update ramp lift angle
-            rampLiftCurrentAngle = rampLiftMotor.rotation(degreesUnit);
+            rampLiftCurrentAngle = sensors.position[SensorSnapshot::RAMP_LIFT];
 
             // if ramp lift position is at the maximum or minimums, only allow movement in the opposite direction
             if (rampLiftCurrentAngle >= rampLiftUpperAngle) {
@@ -763,79 +1732,217 @@ class Robot {
         };
     
         /* ------------------------------------------------------------------------
-        * Function: rampLiftUntilExtrema (version of rampLift function for AUTONOMOUS)
-        * Desc: ramp lifting function to place stack down for AUTONOMOUS
+        * Function: rampLiftUntilExtremaAsync (version of rampLift function for AUTONOMOUS)
+        * Desc: ramp lifting function to place stack down for AUTONOMOUS. Starts the movement and returns right away; the movement runs on the
+        *       control scheduler ticks. Waits for any ramp movement that is still running first
         * Param:
         *   -true for forward / placing mode, false for retracted / stacking mode
         *   -speed to apply to motors in percent of motor speed ranging 0-1
-        * Output: activates or deactivates ramp lift
+        * Output: MotionHandle to await or poll the movement
         */
-        void rampLiftUntilExtrema(bool placeOrRetract, double percentSpeed) {
+        MotionHandle rampLiftUntilExtremaAsync(bool placeOrRetract, double percentSpeed) {
+            awaitIdle(rampChannel);
+            
             // update ramp lift angle
-            rampLiftCurrentAngle = rampLiftMotor.rotation(degreesUnit);
+            rampLiftCurrentAngle = sensors.position[SensorSnapshot::RAMP_LIFT];
+            unsigned int sequence = rampChannel.begin();
+            rampRecord = routineProfiler.begin("rampLift", placeOrRetract ? 1 : 0);
+            rampTrace = trace.begin("rampLift", TRACK_RAMP, placeOrRetract ? 1 : 0);
             
             // hold arm steady if function argument speed is 0. Else, move ramp lift forward or back until it reaches its maximum or minimum
             if (percentSpeed == 0) {
                 rampLiftMotor.stop(vex::brakeType::hold);
+                rampChannel.finish();
+                routineProfiler.end(rampRecord);
+                trace.end(rampTrace);
             } else {
-                if (!placeOrRetract) {
-                    while(rampLiftCurrentAngle <= rampLiftUpperAngle) {
-                        runPrint("a");
-                        rampLiftCurrentAngle = rampLiftMotor.rotation(degreesUnit);
-                        rampLiftMotor.spin(forwardDirection, percentSpeed * 100, percentVelocityUnit);
-                    }
-                    rampLiftMotor.stop(vex::brakeType::hold);
-                } else {
-                    while(rampLiftCurrentAngle >= rampLiftLowerAngle) {
-                        runPrint("b");
-                        rampLiftCurrentAngle = rampLiftMotor.rotation(degreesUnit);
-                        rampLiftMotor.spin(reverseDirection, percentSpeed * 100, percentVelocityUnit);
-                    }
-                    rampLiftMotor.stop(vex::brakeType::hold);
-                }
+                rampPlaceOrRetract = placeOrRetract;
+                rampSpeed = percentSpeed;
+                double extremeAngle = placeOrRetract ? rampLiftLowerAngle : rampLiftUpperAngle;
+                // the direction comes from placeOrRetract; a negative speed would empty the profile and turn the PID clamp inside out
+                rampProfile = SCurveProfile(extremeAngle - rampLiftCurrentAngle, fabs(percentSpeed) * liftMaxVelocity, rampMaxAcceleration, rampMaxJerk);
+                rampProfileTime = 0;
+                rampPid.reset();
+                rampPid.setOutputLimit(fabs(percentSpeed) * 100);
+                rampSettle.reset();
+                rampMotion = true;
+            }
+            return MotionHandle(&controlScheduler, &rampChannel, sequence);
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: rampLiftUntilExtrema (version of rampLift function for AUTONOMOUS)
+        * Desc: ramp lifting function to place stack down for AUTONOMOUS. Blocking version of rampLiftUntilExtremaAsync
+        * Param:
+        *   -true for forward / placing mode, false for retracted / stacking mode
+        *   -speed to apply to motors in percent of motor speed ranging 0-1
+        * Output: activates or deactivates ramp lift
+        */
+        void rampLiftUntilExtrema(bool placeOrRetract, double percentSpeed) {
+            rampLiftUntilExtremaAsync(placeOrRetract, percentSpeed).await();
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: updateRampLiftUntilExtrema
+        * Desc: one control tick of rampLiftUntilExtremaAsync. The ramp lift follows the S-curve profile to its maximum or minimum: the profile
+        *       velocity is fed forward and the ramp PID corrects the error to the profile angle
+        * Param: seconds since the previous tick
+        * Output: returns true once the ramp lift has reached its maximum or minimum and has settled, then holds it
+        */
+        bool updateRampLiftUntilExtrema(double dt) {
+            rampLiftCurrentAngle = sensors.position[SensorSnapshot::RAMP_LIFT];
+            double extremeAngle = rampPlaceOrRetract ? rampLiftLowerAngle : rampLiftUpperAngle;
+            double angleError = extremeAngle - rampLiftCurrentAngle;
+            
+            // the settle detector watches the whole motion: it finishes once the ramp lift has come to rest at its maximum or minimum, or once
+            // the stack has held it short of it for the settle timeout
+            if (rampProfile.isFinished(rampProfileTime) && fabs(angleError) < rampSettleTolerance) {
+                routineProfiler.settling(rampRecord);
+            }
+            if (rampSettle.update(angleError, sensors.velocity[SensorSnapshot::RAMP_LIFT])) {
+                rampLiftMotor.stop(vex::brakeType::hold);
+                return true;
             }
+            
+            rampProfileTime += dt;
+            ProfileState setpoint = rampProfile.sample(rampProfileTime);
+            double setpointAngle = extremeAngle - rampProfile.getDistance() + setpoint.position;
+            
+            double percentSpeed = setpoint.velocity / liftMaxVelocity * 100 + rampPid.update(setpointAngle - rampLiftCurrentAngle, dt);
+            rampLiftMotor.spin(forwardDirection, fmax(-100, fmin(100, percentSpeed)), percentVelocityUnit);
+            return false;
         };
     
         /* ------------------------------------------------------------------------
         * Function: safeStack
         * Desc: Ensures robot is positioned correctly with sonars then stacks if aligned
         * Param:
-        *   - VEX object of the first sonar
-        *   - VEX object of the second sonar
+        *   - the first sonar
+        *   - the second sonar
         *   - target distance for the first sonar to reach (meters)
         *   - target distance for the second sonar to reach (meters)
         *   - precision threshold or tolerance for the sonars (meters)
         * Output: activates or deactivates ramp lift
         */
-        void safeStack(vex::sonar sonarOne, vex::sonar sonarTwo, double sonarOneTarget, double sonarTwoTarget, double precisionThreshold) {
+        void safeStack(SensorSnapshot::Sonar sonarOne, SensorSnapshot::Sonar sonarTwo, double sonarOneTarget, double sonarTwoTarget, double precisionThreshold) {
             
             bool isSafe = true;
             
             // if the sonar distances are within threshold (meaning the robot is correctly positioned), then perform a stack
-            if (!(fabs(sonarOneTarget - (sonarOne.distance(millimeterUnits) / 1000)) <= precisionThreshold)) {
+            if (!(fabs(sonarOneTarget - sensors.sonar[sonarOne]) <= precisionThreshold)) {
                 isSafe = false;
                 runPrint("Safe stack aborted due to Sonar One out of Threshold");
-                runPrint(fabs(sonarOneTarget - (sonarOne.distance(millimeterUnits) / 1000)));
+                runPrint(fabs(sonarOneTarget - sensors.sonar[sonarOne]));
             }
-            if (!(fabs(sonarTwoTarget - (sonarTwo.distance(millimeterUnits) / 1000)) <= precisionThreshold)) {
+            if (!(fabs(sonarTwoTarget - sensors.sonar[sonarTwo]) <= precisionThreshold)) {
                 isSafe = false;
                 runPrint("Safe stack aborted due to Sonar Two out of Threshold");
-                runPrint(fabs(sonarOneTarget - (sonarTwo.distance(millimeterUnits) / 1000)));
+                runPrint(fabs(sonarOneTarget - sensors.sonar[sonarTwo]));
             }
             
-            runPrint(fabs(sonarOneTarget - (sonarOne.distance(millimeterUnits) / 1000)));
+            runPrint(fabs(sonarOneTarget - sensors.sonar[sonarOne]));
             
             if (isSafe) {
                 // Place stack
                 intakeSpin(true, 0); // stop intakes
                 rampLiftUntilExtrema(true, 0.7); // ramp forward
-                vex::task::sleep(500);
+                sleepFor(500);
                 intakeSpin(false, 0.2); // slow outtake
-                vex::task::sleep(500);
+                sleepFor(500);
                 linearMove(-0.6, 0.1); // back 0.6
             }
         }
     
+        /* ------------------------------------------------------------------------
+        * Function: loadFeedforward / saveFeedforward
+        * Desc: reads or writes the base feedforward gains fitted by characterizeDrive on the SD card
+        * Param: none
+        * Output: keeps the current gains if there is no SD card or no valid gains file
+        */
+        void loadFeedforward() {
+            if (!Brain.SDcard.isInserted()) {
+                return;
+            }
+            DriveFeedforward::Gains gains;
+            if (Brain.SDcard.loadfile(feedforwardFile, (uint8_t *) &gains, sizeof(gains)) == (int32_t) sizeof(gains)) {
+                baseFeedforward.fromGains(gains);
+            }
+        };
+        void saveFeedforward() {
+            if (!Brain.SDcard.isInserted()) {
+                runPrint("No SD card, feedforward gains not saved");
+                return;
+            }
+            DriveFeedforward::Gains gains = baseFeedforward.toGains();
+            Brain.SDcard.savefile(feedforwardFile, (uint8_t *) &gains, sizeof(gains));
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: runCharacterizationTest
+        * Desc: drives the base straight at a ramped or stepped voltage and records every tick in the fitter. Stops once the robot has driven
+        *       the given distance or the time runs out, then lets the base come to rest
+        * Param:
+        *   - direction 1 for forwards, -1 for backwards
+        *   - starting voltage (percent of full voltage). 0 for a quasi-static test, the step size for a step test
+        *   - voltage ramp rate (percent of full voltage / second). 0 for a step test
+        *   - maximum distance to drive (meters) and maximum time (seconds)
+        *   - fitter to record the samples in
+        * Output: moves robot base
+        */
+        void runCharacterizationTest(double direction, double startVoltage, double rampRate, double maxDistance, double maxTime, FeedforwardFitter &fitter) {
+            double startDistance = (odometry.getLeftDistance() + odometry.getRightDistance()) / 2;
+            double previousVelocity = odometry.getVelocity();
+            double acceleration = 0;
+            double time = 0;
+            double voltage = startVoltage;
+            
+            controlScheduler.setLoop(LOOP_CHARACTERIZATION);
+            controlScheduler.start();
+            while (time < maxTime && fabs((odometry.getLeftDistance() + odometry.getRightDistance()) / 2 - startDistance) < maxDistance) {
+                voltage = fmin(100, startVoltage + rampRate * time);
+                baseVoltageMove(direction * voltage, direction * voltage);
+                
+                controlScheduler.waitForNextTick();
+                double dt = controlScheduler.lastTickInterval();
+                time += dt;
+                
+                // the voltage of the last tick produced the velocity measured now; the acceleration is smoothed like the PID derivative
+                double velocity = odometry.getVelocity();
+                if (dt > 0) {
+                    acceleration = 0.5 * acceleration + 0.5 * (velocity - previousVelocity) / dt;
+                }
+                previousVelocity = velocity;
+                fitter.addSample(direction * voltage, velocity, acceleration);
+            }
+            
+            baseMove(0, 0);
+            sleepFor(1000);
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: characterizeDrive
+        * Desc: runs the drive characterization: quasi-static tests (slow voltage ramp, the robot never accelerates noticeably, so they measure kS and kV)
+        *       and step voltage tests (sudden voltage, so they measure kA) forwards and backwards. Fits kS, kV and kA to all of them together and stores
+        *       the result on the SD card. Needs about 1.5 meters of clear field in front of the robot
+        * Param: none
+        * Output: updates baseFeedforward and prints the fitted gains
+        */
+        void characterizeDrive() {
+            FeedforwardFitter fitter;
+            
+            runCharacterizationTest(1, 0, 4, 1.2, 20, fitter);
+            runCharacterizationTest(-1, 0, 4, 1.2, 20, fitter);
+            runCharacterizationTest(1, 50, 0, 1.2, 2, fitter);
+            runCharacterizationTest(-1, 50, 0, 1.2, 2, fitter);
+            
+            if (fitter.fit(baseFeedforward)) {
+                saveFeedforward();
+                logger.log("kS %g kV %g kA %g", baseFeedforward.getKS(), baseFeedforward.getKV(), baseFeedforward.getKA());
+            } else {
+                runPrint("Characterization failed, feedforward gains unchanged");
+            }
+        };
+    
         /* ------------------------------------------------------------------------
         * Function: autonomousSelector
         * Desc: Allows user to SELECT which AUTONOMOUS ROUTINE to use during PRE-AUTONOMOUS
@@ -865,41 +1972,209 @@ class Robot {
         }*/
     
         
+        /* ------------------------------------------------------------------------
+        * Function: startRoutine
+        * Desc: starts an autonomous routine from its starting tile: runs the control scheduler, the telemetry and the trace, and starts timing it
+        * Param: routine number
+        * Output: returns the trace event of the routine, for finishRoutine
+        */
+        int startRoutine(int routineNumber) {
+            becomeControlTask();
+            startTelemetry();
+            startTrace("trace-autonomous.json");
+            int routineTrace = trace.begin("autonomousMain", TRACK_ROUTINE, routineNumber);
+            runPrint("Started autonomousMain", 1);
+            
+            // every routine starts from its starting tile: the field frame is the robot's starting pose
+            odometry.setPose(0, 0, 0);
+            targetPose = odometry.getPose();
+            controlScheduler.setLoop(LOOP_AUTONOMOUS);
+            controlScheduler.start();
+            readSensors();
+            routineProfiler.startRoutine();
+            autonomousRunning = true;
+            return routineTrace;
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: finishRoutine
+        * Desc: finishes an autonomous routine started with startRoutine
+        * Param: routine number, trace event returned by startRoutine
+        * Output: reports how long the routine took on the brain screen
+        */
+        void finishRoutine(int routineNumber, int routineTrace) {
+            routineProfiler.finishRoutine();
+            autonomousRunning = false;
+            trace.end(routineTrace);
+            finishTrace();
+            const ControlScheduler::Statistics &loop = controlScheduler.statistics(LOOP_AUTONOMOUS);
+            logger.log("loop: %lu ticks %lu overruns busy %.2f jitter %.3f ms", (unsigned long) loop.ticks, (unsigned long) loop.overruns,
+                       loop.maxBusyMicros / 1000.0, loop.rmsJitterMicros() / 1000);
+            logger.log("Routine %d took %g s", routineNumber, routineProfiler.routineMicros() / 1000000.0);
+        };
+    
     public:
+        /*
+        * GET functions
+        */
+        const RoutineProfiler &getRoutineProfiler() const {
+            return routineProfiler;
+        };
+        const Pose &getPose() const {
+            return odometry.getPose();
+        };
+        const Pose &getTargetPose() const {
+            return targetPose;
+        };
+        const SensorSnapshot &getSensors() const {
+            return sensors;
+        };
+        const MotorGroup &getBaseMotors() const {
+            return baseMotors;
+        };
+        const TelemetryRecorder &getTelemetry() const {
+            return telemetry;
+        };
+        TraceRecorder &getTrace() {
+            return trace;
+        };
+        const ControlScheduler &getControlScheduler() const {
+            return controlScheduler;
+        };
+        const LatencyMeter &getLatencyMeter() const {
+            return latency;
+        };
+        const ControllerInput &getControllerInput() const {
+            return controllerInput;
+        };
+
+        /*
+        * SET functions
+        */
+        // replaces the gains and thresholds of tuned-gains.h, e.g. with a candidate of the gain tuner. Call it while no motion runs
+        void setGains(const RobotGains &gains) {
+            kpLinear = gains.kpLinear;
+            kpRotational = gains.kpRotational;
+            linearPrecisionThreshold = gains.linearPrecisionThreshold;
+            rotationalPrecisionThreshold = gains.rotationalPrecisionThreshold;
+            armPivotThreshold = gains.armPivotThreshold;
+            // the base motions set the base settle tolerances when they start; the arm settle tolerance is only set here
+            armSettle.setTolerances(armPivotThreshold, settleVelocity);
+            linearPid.setGains(gains.linearPidKp, gains.linearPidKi, gains.linearPidKd);
+            rotationalPid.setGains(gains.rotationalPidKp, gains.rotationalPidKi, gains.rotationalPidKd);
+            armPid.setGains(gains.armPidKp, gains.armPidKi, gains.armPidKd);
+            rampPid.setGains(gains.rampPidKp, gains.rampPidKi, gains.rampPidKd);
+            leftArcPid.setGains(gains.linearPidKp, gains.linearPidKi, gains.linearPidKd);
+            rightArcPid.setGains(gains.linearPidKp, gains.linearPidKi, gains.linearPidKd);
+        };
+        // true to measure the time from each controller input change to its motor command during driver control. Call before driverMain
+        void setLatencyMeasurement(bool measure) {
+            measureLatency = measure;
+        };
+    
         // Constructor, aka Pre-Autonomous
         Robot() {
             //autonomousSelector();
             
+            sensors.sequence = 0;
+            readSensors();
+            
             // set up ramp lift angles according to ramp lift starting position
-            rampLiftCurrentAngle = rampLiftMotor.rotation(degreesUnit);
+            rampLiftCurrentAngle = sensors.position[SensorSnapshot::RAMP_LIFT];
             rampLiftUpperAngle = rampLiftCurrentAngle + rampLiftUpperAngle;
             rampLiftLowerAngle = rampLiftCurrentAngle + rampLiftLowerAngle;
             
             // set up arm pivot angles according to arm pivot starting position
-            armPivotCurrentAngle = armPivotMotor.rotation(degreesUnit);
+            armPivotCurrentAngle = sensors.position[SensorSnapshot::ARM_PIVOT];
             armPivotUpperAngle = armPivotCurrentAngle + armPivotUpperAngle;
             armPivotLowerAngle = armPivotCurrentAngle + armPivotLowerAngle;
 
             rampLiftMotor.setMaxTorque(100,percentUnit);
             
+            // use the fitted drive feedforward gains if characterizeDrive has stored them
+            loadFeedforward();
+            
             baseTopLeftMotor.setStopping(vex::brakeType::brake);
             baseTopRightMotor.setStopping(vex::brakeType::brake);
             baseBottomLeftMotor.setStopping(vex::brakeType::brake);
             baseBottomRightMotor.setStopping(vex::brakeType::brake);
+            
+            // right motors are reverse to map properly to motor orientation on physical robot
+            baseMotors.add(baseTopLeftMotor, false);
+            baseMotors.add(baseBottomLeftMotor, false);
+            baseMotors.add(baseTopRightMotor, true);
+            baseMotors.add(baseBottomRightMotor, true);
+            
+            // read the sensors, integrate the base encoders into the field pose, advance background motions, record the tick and publish the status
+            // for the screen task, then trace the tick, once per control tick
+            updateOdometry(0);
+            controlScheduler.addJob(sensorJob, this);
+            controlScheduler.addJob(odometryJob, this);
+            controlScheduler.addJob(motionJob, this);
+            controlScheduler.addJob(telemetryJob, this);
+            controlScheduler.addJob(statusJob, this);
+            controlScheduler.addJob(traceJob, this);
+            controlScheduler.setLoopName(LOOP_AUTONOMOUS, "autonomous");
+            controlScheduler.setLoopName(LOOP_DRIVER, "driver");
+            controlScheduler.setLoopName(LOOP_CHARACTERIZATION, "characterize");
+            
+            trace.setTrack(TRACK_ROUTINE, "routine", "argument");
+            trace.setTrack(TRACK_BASE, "base", "argument");
+            trace.setTrack(TRACK_ARM, "arm", "argument");
+            trace.setTrack(TRACK_RAMP, "ramp", "argument");
+            trace.setTrack(TRACK_TICKS, "control ticks", "jobs us");
+            
+            latency.setChannelName(LATENCY_BASE, "base");
+            latency.setChannelName(LATENCY_INTAKE, "intake");
+            latency.setChannelName(LATENCY_ARM, "arm");
+            latency.setChannelName(LATENCY_RAMP, "ramp");
+            
+            // the base handler runs first: B also spins the intake out, which the intake handler leaves alone while X or B is held
+            controllerInput.addHandler(baseButtons, baseAxes, false, baseInputHandler, this);
+            controllerInput.addHandler(intakeButtons, 0, false, intakeInputHandler, this);
+            controllerInput.addHandler(armButtons, 0, true, armInputHandler, this);
+            controllerInput.addHandler(rampButtons, 0, true, rampInputHandler, this);
+        };
+        
+        ~Robot() {
+            // the screen and log tasks drain this robot's buffers
+            if (tasksStarted) {
+                screenTask.stop();
+                logTask.stop();
+            }
+            // write what is left of the telemetry and the trace, now that the task that writes them is gone
+            if (telemetryStarted) {
+                telemetry.closeBlock();
+                telemetry.flush(writeCardFile, (void *) telemetryFile);
+                finishTrace();
+                if (traceExportRequested) {
+                    trace.writeJson(writeCardFile, (void *) traceFile);
+                }
+            }
+        };
+
+        // starts the screen and log tasks, from main() or else the first time the robot program runs a routine or the driver loop
+        void startTasks() {
+            if (!tasksStarted) {
+                screenTask = vex::task(screenTaskEntry, this, screenTaskPriority);
+                logTask = vex::task(logTaskEntry, this, logTaskPriority);
+                tasksStarted = true;
+            }
         };
     
         /* ------------------------------------------------------------------------
         * Function: autonomousMain
         * Desc: Runs autonomous procedure
         * Param: none
-        * Output: Moves robot according to preprogrammed autonomous procedure
+        * Output: Moves robot according to preprogrammed autonomous procedure, then prints how long it took. getRoutineProfiler has the time of every primitive
         */
         void autonomousMain( int routineNumber ) {
-            runPrint("Started autonomousMain", 1);
+            int routineTrace = startRoutine(routineNumber);
             
             /*
             * use linearMove(distance in meters, percent power from 0-1) for forward/backwards movement
             * use rotationalMove(rotation in degrees, percent power from 0-1) for rotating or pivoting in place
+            * use rotationalMove(radius in meters, rotation in degrees, percent power from 0-1) for sweeping around a turn while driving forwards
             */
             
             /*
@@ -910,64 +2185,57 @@ class Robot {
                 case 1: {
                         // RED FRONT
                         
-                        // Flip Out / Initation
-                        armPivotUntilPercent(0.6, 1);
-                        armPivotUntilPercent(0, 1);
+                        // Flip Out / Initation while the robot drives to the inside row of cubes: the arm goes up and comes back down on the way
+                        MotionHandle flipOut = armPivotUntilPercentAsync(0.6, 1);
                         intakeSpin(true,1); // spin in intake
                         
                         // Pick up inside row of cubes
-                        linearMove(1.2, 0.6);
-                        vex::task::sleep(200);
-                        linearMove(-0.932, 0.8);
-                        //linearSonarMove(0.268, 0.8, backSonar); // back up until 0.27 m from the wall
-                        vex::task::sleep(200);
+                        MotionHandle drive = linearMoveAsync(1.2, 0.8);
+                        flipOut.await();
+                        flipOut = armPivotUntilPercentAsync(0, 1);
+                        drive.await();
+                        flipOut.await();
+                        linearMove(-0.932, 1);
+                        //linearSonarMove(0.268, 0.8, SensorSnapshot::BACK_SONAR); // back up until 0.27 m from the wall
 
                         // Turn and proceed to outside row of cubes
-                        rotationalMove(94, 0.175);
-                        vex::task::sleep(300);
-                        linearMove(0.63, 0.6);
-                        vex::task::sleep(200);
-                        rotationalMove(-78, 0.2);
-                        vex::task::sleep(200);
+                        rotationalMove(94, 0.5);
+                        linearMove(0.63, 0.8);
+                        rotationalMove(-78, 0.5);
 
                         // Pick up outside row of cubes
-                        linearMove(1, 0.6);
-                        vex::task::sleep(200);
-                        rotationalMove(-45, 0.2);
-                        vex::task::sleep(200);
-                        linearMove(0.2, 0.5);
-                        vex::task::sleep(200);
-                        linearMove(-0.2, 0.5);
-                        vex::task::sleep(200);
-
-                        rotationalMove(225, 0.15);
-                        vex::task::sleep(200);
                         linearMove(1, 0.8);
+                        rotationalMove(-45, 0.5);
+                        linearMove(0.2, 0.8);
+                        linearMove(-0.2, 0.8);
+
+                        rotationalMove(225, 0.5);
+                        linearMove(1, 1);
                         //linearMove(-0.8, 0.8);
-                        //linearSonarMove(0.38, 0.8, backSonar); // back up until 0.6 m from the wall
-                        //vex::task::sleep(200);
+                        //linearSonarMove(0.38, 0.8, SensorSnapshot::BACK_SONAR); // back up until 0.6 m from the wall
+                        //sleepFor(200);
 
                         // Turn and move towards goal
                         //rotationalMove(150, 0.2);
-                        //vex::task::sleep(200);
+                        //sleepFor(200);
                         //linearMove(0.37, 0.6);
                         
                         /*
                         // Spit out one cube into the goal
                         intakeSpin(false, 1);
-                        vex::task::sleep(500);
+                        sleepFor(500);
                         intakeSpin(true, 0);
-                        vex::task::sleep(200);
+                        sleepFor(200);
                         linearMove(-0.6, 0.8);
-                        vex::task::sleep(5000);
+                        sleepFor(5000);
                         */
                         /*
                         // Place Stack
                         intakeSpin(false, 0.5); // out take a litle bit
-                        vex::task::sleep(400);
+                        sleepFor(400);
                         intakeSpin(true, 0);
-                        safeStack(rightSonar, leftSonar, 0.3, 0.3, 0.2); // safe stack
-                        vex::task::sleep(5000); // wait 5 seconds
+                        safeStack(SensorSnapshot::RIGHT_SONAR, SensorSnapshot::LEFT_SONAR, 0.3, 0.3, 0.2); // safe stack
+                        sleepFor(5000); // wait 5 seconds
                         */
                         break;
                     };
@@ -975,44 +2243,42 @@ class Robot {
                         // RED BACK
 
 
-                        // Flip out ramp
-                        armPivotUntilPercent(0.4, 1);
-                        armPivotUntilPercent(0, 1);
+                        // Flip out ramp while the robot picks up the starter block
+                        MotionHandle flipOut = armPivotUntilPercentAsync(0.4, 1);
 
                         intakeSpin(true, 1); // spin in intake
 
-                        // Put starter block in tower
-                        linearMove(0.1, 0.5);
-                        vex::task::sleep(300);
+                        // Put starter block in tower. The arm comes back down and goes up again while turning and driving towards the tower
+                        linearMove(0.1, 0.8);
+                        sleepFor(300);
                         intakeSpin(true,0);
-                        armPivotUntilPercent(armPivotIncrementalPercents[2], 1);
-                        rotationalMove(45, 0.4);
-                        vex::task::sleep(200);
-                        linearMove(0.25, 0.7);
+                        flipOut.await();
+                        flipOut = armPivotUntilPercentAsync(0, 1);
+                        MotionHandle turn = rotationalMoveAsync(45, 0.5);
+                        flipOut.await();
+                        MotionHandle armUp = armPivotUntilPercentAsync(armPivotIncrementalPercents[2], 1);
+                        turn.await();
+                        linearMove(0.25, 0.8);
+                        armUp.await();
                         intakeSpin(false, 1);
-                        vex::task::sleep(1000);
+                        sleepFor(1000);
                         intakeSpin(true,0);
-                        linearMove(-0.25, 0.7);
-                        armPivotUntilPercent(armPivotIncrementalPercents[0], 1);
                         
-                        // Move to goal
+                        // Move to goal. The arm comes down while backing away from the tower and turning
+                        MotionHandle armDown = armPivotUntilPercentAsync(armPivotIncrementalPercents[0], 1);
+                        linearMove(-0.25, 0.8);
                         intakeSpin(true, 1);
-                        rotationalMove(-60, 0.4);
-                        vex::task::sleep(200);
-                        linearMove(0.3, 0.7);
-                        vex::task::sleep(200);
-                        rotationalMove(-50, 0.4);
-                        vex::task::sleep(200);
-                        linearMove(0.6, 0.7);
-                        vex::task::sleep(200);
-                        rotationalMove(-45, 0.4);
-                        vex::task::sleep(200);
+                        rotationalMove(-60, 0.5);
+                        armDown.await();
+                        linearMove(0.3, 0.8);
+                        rotationalMove(-50, 0.5);
+                        linearMove(0.6, 0.8);
+                        rotationalMove(-45, 0.5);
                         linearMove(0.4, 1);
-                        vex::task::sleep(200);
 
                         // spit out cubes
                         intakeSpin(false, 1);
-                        vex::task::sleep(1500);
+                        sleepFor(1500);
                         linearMove(-0.3, 1);
 
                         break;
@@ -1020,52 +2286,45 @@ class Robot {
                 case 3: {
                         // BLUE FRONT
                         
-                        // Flip Out / Initation
-                        armPivotUntilPercent(0.6, 1);
-                        armPivotUntilPercent(0, 1);
+                        // Flip Out / Initation while the robot drives to the inside row of cubes: the arm goes up and comes back down on the way
+                        MotionHandle flipOut = armPivotUntilPercentAsync(0.6, 1);
                         intakeSpin(true,1); // spin in intake
                         
                         // Pick up inside row of cubes
-                        linearMove(1.2, 0.6);
-                        vex::task::sleep(200);
-                        linearMove(-0.932, 0.8);
-                        //linearSonarMove(0.268, 0.8, backSonar); // back up until 0.27 m from the wall
-                        vex::task::sleep(200);
+                        MotionHandle drive = linearMoveAsync(1.2, 0.8);
+                        flipOut.await();
+                        flipOut = armPivotUntilPercentAsync(0, 1);
+                        drive.await();
+                        flipOut.await();
+                        linearMove(-0.932, 1);
+                        //linearSonarMove(0.268, 0.8, SensorSnapshot::BACK_SONAR); // back up until 0.27 m from the wall
 
                         // Turn and proceed to outside row of cubes
-                        rotationalMove(-94, 0.175);
-                        vex::task::sleep(300);
-                        linearMove(0.63, 0.6);
-                        vex::task::sleep(200);
-                        rotationalMove(78, 0.2);
-                        vex::task::sleep(200);
+                        rotationalMove(-94, 0.5);
+                        linearMove(0.63, 0.8);
+                        rotationalMove(78, 0.5);
 
                         // Pick up outside row of cubes
-                        linearMove(1, 0.6);
-                        vex::task::sleep(200);
-                        rotationalMove(45, 0.2);
-                        vex::task::sleep(200);
-                        linearMove(0.2, 0.5);
-                        vex::task::sleep(200);
-                        linearMove(-0.2, 0.5);
-                        vex::task::sleep(200);
-                        
-                        rotationalMove(-225, 0.15);
-                        vex::task::sleep(200);
                         linearMove(1, 0.8);
+                        rotationalMove(45, 0.5);
+                        linearMove(0.2, 0.8);
+                        linearMove(-0.2, 0.8);
+                        
+                        rotationalMove(-225, 0.5);
+                        linearMove(1, 1);
                         
 
                         /*
                         // Place Stack
                         intakeSpin(false, 0.4); // out take a litle bit
-                        vex::task::sleep(1000);
+                        sleepFor(1000);
                         intakeSpin(true, 0); // stop intakes
                         rampLiftUntilExtrema(true, 0.7); // ramp forward
-                        vex::task::sleep(500);
+                        sleepFor(500);
                         intakeSpin(false, 0.2); // slow outtake
-                        vex::task::sleep(200);
+                        sleepFor(200);
                         linearMove(-0.6, 0.1); // back 0.6
-                        vex::task::sleep(5000); // wait 5 seconds
+                        sleepFor(5000); // wait 5 seconds
                         */
                         break;
                     };
@@ -1073,45 +2332,43 @@ class Robot {
                         // BLUE BACK
 
 
-                        // Flip out ramp
-                        armPivotUntilPercent(0.4, 1);
-                        armPivotUntilPercent(0, 1);
+                        // Flip out ramp while the robot picks up the starter block
+                        MotionHandle flipOut = armPivotUntilPercentAsync(0.4, 1);
                         
                         // Spin in intakes
                         intakeSpin(true, 1);
 
-                        // Put starter block in tower
-                        linearMove(0.1, 0.5);
-                        vex::task::sleep(300);
+                        // Put starter block in tower. The arm comes back down and goes up again while turning and driving towards the tower
+                        linearMove(0.1, 0.8);
+                        sleepFor(300);
                         intakeSpin(true,0);
-                        armPivotUntilPercent(armPivotIncrementalPercents[2], 1);
-                        rotationalMove(-45, 0.2);
-                        vex::task::sleep(200);
-                        linearMove(0.25, 0.7);
+                        flipOut.await();
+                        flipOut = armPivotUntilPercentAsync(0, 1);
+                        MotionHandle turn = rotationalMoveAsync(-45, 0.5);
+                        flipOut.await();
+                        MotionHandle armUp = armPivotUntilPercentAsync(armPivotIncrementalPercents[2], 1);
+                        turn.await();
+                        linearMove(0.25, 0.8);
+                        armUp.await();
                         intakeSpin(false, 1);
-                        vex::task::sleep(1000);
+                        sleepFor(1000);
                         intakeSpin(true,0);
-                        linearMove(-0.2, 0.6);
-                        armPivotUntilPercent(armPivotIncrementalPercents[0], 1);
-                        vex::task::sleep(200);
 
-                        // Move to goal
+                        // Move to goal. The arm comes down while backing away from the tower and turning
+                        MotionHandle armDown = armPivotUntilPercentAsync(armPivotIncrementalPercents[0], 1);
+                        linearMove(-0.2, 0.8);
                         intakeSpin(true, 1);
-                        rotationalMove(65, 0.2);
-                        vex::task::sleep(200);
-                        linearMove(0.3, 0.7);
-                        vex::task::sleep(200);
-                        rotationalMove(50, 0.2);
-                        vex::task::sleep(200);
-                        linearMove(0.7, 0.6);
-                        vex::task::sleep(250);
-                        rotationalMove(70, 0.2);
-                        vex::task::sleep(200);
-                        linearMove(0.4, 0.7);
+                        rotationalMove(65, 0.5);
+                        armDown.await();
+                        linearMove(0.3, 0.8);
+                        rotationalMove(50, 0.5);
+                        linearMove(0.7, 0.8);
+                        rotationalMove(70, 0.5);
+                        linearMove(0.4, 0.8);
 
                         // spit out cubes
                         intakeSpin(false, 1);
-                        vex::task::sleep(1500);
+                        sleepFor(1500);
                         linearMove(-0.2, 1);
 
                         break;
@@ -1121,71 +2378,62 @@ class Robot {
                   // place in red front starting position 
                         // Flip Out / Initation
                         armPivotUntilPercent(0.6, 1);
-                        armPivotUntilPercent(0, 1);
+                        MotionHandle flipOut = armPivotUntilPercentAsync(0, 1);
 
-                        // intake starter cube
+                        // intake starter cube while the arm comes back down
                         intakeSpin(true,1);
                         linearMove(0.3, 0.8);
                         intakeSpin(true,0);
-                        vex::task::sleep(200);
+                        sleepFor(200);
+                        flipOut.await();
                         
-                        // place multiplier in alliance tower
+                        // place multiplier in alliance tower. Raise the arm while turning towards the tower
+                        MotionHandle armUp = armPivotUntilPercentAsync(armPivotIncrementalPercents[1], 1);
                         rotationalMove(60, 0.15);
-                        vex::task::sleep(200);
-                        armPivotUntilPercent(armPivotIncrementalPercents[1], 1);
+                        armUp.await();
                         linearMove(0.35, 0.6);
                         intakeSpin(false, 1);
-                        vex::task::sleep(1000);
+                        sleepFor(1000);
                         intakeSpin(true, 0);
                         linearMove(-0.33, 0.8);
-                        armPivotUntilPercent(armPivotIncrementalPercents[0], 1);
+                        MotionHandle armDown = armPivotUntilPercentAsync(armPivotIncrementalPercents[0], 1);
 
-                        // move back to line up with the outside row of cubes
+                        // move back to line up with the outside row of cubes while the arm comes down
                         rotationalMove(45, 0.15);
-                        vex::task::sleep(200);
                         linearMove(-0.6, 0.7);
-                        vex::task::sleep(200);
                         rotationalMove(-92, 0.15);
-                        vex::task::sleep(200);
                         intakeSpin(true, 1);
-                        vex::task::sleep(200);
+                        sleepFor(200);
+                        armDown.await();
 
                         // get row of inside cubes
                         linearMove(2.7, 0.3);
-                        vex::task::sleep(200);
                         linearMove(0.2, 0.8);
-                        vex::task::sleep(200);
                         rotationalMove(90, 0.15);
-                        vex::task::sleep(200);
 
                         // move to goal
                         linearMove(1.2, 0.8);
-                        vex::task::sleep(200);
                         rotationalMove(-45, 0.15);
-                        vex::task::sleep(200);
 
                         // stack in unprotected goal
                         linearMove(0.37, 0.5);
                         intakeSpin(false, 0.5); // out take a litle bit
-                        vex::task::sleep(400);
+                        sleepFor(400);
                         intakeSpin(true, 0);
                         rampLiftUntilExtrema(true, 0.7);
-                        vex::task::sleep(500);
+                        sleepFor(500);
                         intakeSpin(false, 0.2); // slow outtake
-                        vex::task::sleep(500);
+                        sleepFor(500);
                         linearMove(-0.4, 0.1); // back 0.6
-                        vex::task::sleep(200);
 
                         // move towards tower
                         rotationalMove(135, 0.2);
-                        vex::task::sleep(200);
                         linearMove(1.2, 0.8);
-                        vex::task::sleep(400);
+                        MotionHandle towerArmUp = armPivotUntilPercentAsync(armPivotIncrementalPercents[1], 1); // raise the arm while backing up
                         linearMove(-0.2, 0.5);
-                        vex::task::sleep(200);
-                        armPivotUntilPercent(armPivotIncrementalPercents[1], 1);
+                        towerArmUp.await();
                         intakeSpin(false, 1);
-                        vex::task::sleep(1000);
+                        sleepFor(1000);
                         intakeSpin(true, 0);
                         armPivotUntilPercent(armPivotIncrementalPercents[0], 1);
 
@@ -1197,22 +2445,94 @@ class Robot {
                     
                     // Flip Out / Initation
                     armPivotUntilPercent(0.6, 1);
-                    armPivotUntilPercent(0, 1);
+                    MotionHandle flipOut = armPivotUntilPercentAsync(0, 1); // arm comes back down while driving
 
                     intakeSpin(true, 1);
                     linearMove(0.6, 0.8);
+                    flipOut.await();
                     intakeSpin(false, 1);
-                    vex::task::sleep(3000);
+                    sleepFor(3000);
                     linearMove(-0.6, 0.8);
 
                     break;
 
                 }
 
+                case 7: {
+                    // RED FRONT, routine 1 with the turns to the outside row of cubes driven as one curved path
+                    
+                    // Flip Out / Initation. The arm comes back down while the robot starts driving
+                    armPivotUntilPercent(0.6, 1);
+                    MotionHandle flipOut = armPivotUntilPercentAsync(0, 1);
+                    intakeSpin(true,1); // spin in intake
+                    
+                    // Pick up inside row of cubes
+                    linearMove(1.2, 0.6);
+                    flipOut.await();
+                    linearMove(-0.932, 0.8);
+                    
+                    // Swing over to the outside row of cubes and pick them up without stopping
+                    rotationalMoveTo(70, 0.175);
+                    Waypoint outsideRow[] = { {0.224, 0.628}, {0.5, 0.75}, {1.185, 0.904} };
+                    followPath(outsideRow, 3, -29, 0.6);
+                    linearMove(0.2, 0.5);
+                    linearMove(-0.2, 0.5);
+                    
+                    rotationalMove(225, 0.15);
+                    linearMove(1, 0.8);
+                    
+                    break;
+                }
+
+                case 8: {
+                    // DRIVE CHARACTERIZATION, not a match routine. Fits and stores the base feedforward gains
+                    characterizeDrive();
+                    
+                    break;
+                }
+
             };
 
-            
-            
+            finishRoutine(routineNumber, routineTrace);
+        };
+    
+        /* ------------------------------------------------------------------------
+        * Function: markInputChanges
+        * Desc: latency measurement of the driver loop. Starts the latency of every subsystem whose controller inputs changed in this tick's
+        *       sensor snapshot, from the time the snapshot was read. Call after controllerInput.update
+        * Param: none
+        * Output: updates the latency meter
+        */
+        void markInputChanges() {
+            uint16_t changed = controllerInput.changedButtons();
+            uint64_t micros = sensors.timestampMicros;
+            if ((changed & baseButtons) || (controllerInput.changedAxes() & baseAxes)) {
+                latency.inputChanged(LATENCY_BASE, micros);
+            }
+            if (changed & intakeButtons) {
+                latency.inputChanged(LATENCY_INTAKE, micros);
+            }
+            if (changed & armButtons) {
+                latency.inputChanged(LATENCY_ARM, micros);
+            }
+            if (changed & rampButtons) {
+                latency.inputChanged(LATENCY_RAMP, micros);
+            }
+        };
+        
+        // logs the latency distribution of every subsystem that has been commanded, every latencyReportMillis
+        void reportLatency() {
+            if (sensors.timestampMicros - latencyReported < (uint64_t) latencyReportMillis * 1000) {
+                return;
+            }
+            latencyReported = sensors.timestampMicros;
+            for (int i = 0; i < LatencyMeter::maxChannels; i++) {
+                const LatencyMeter::Statistics &stats = latency.statistics(i);
+                if (latency.channelName(i) && stats.count > 0) {
+                    logger.log("lat %s: %lu p50 %.1f p99 %.1f max %.1f ms", latency.channelName(i), (unsigned long) stats.count,
+                               stats.percentileMicros(0.5) / 1000, stats.percentileMicros(0.99) / 1000, stats.maxMicros / 1000.0);
+                }
+            }
         };
     
         /* ------------------------------------------------------------------------
@@ -1242,137 +2562,174 @@ class Robot {
         *
         * ------------------------------------------------------------------------
         */
-        /*
-        * Function: driverMain
-        * Desc: Sets up driver controls and checks continuously during driver period to translate to controller inputs
-        * Param: none
-        * Output: Allows driver to control robot
+        /* ------------------------------------------------------------------------
+        * Function: handleBaseInput
+        * Desc: base handler of the driver loop, called when stick 3, stick 1, X or B changed
+        * Param: controller input
+        * Output: moves robot base
         */
-        void driverMain( void ) {
-            //runPrint("Started driverMain", 1);
-            
-            // CONTROLLER VALUES
-            double stick3;
-            double stick1;
-
-            bool buttonR2;
-            bool buttonR1;
+        void handleBaseInput(const ControllerInput &input) {
+            double stick3 = input.axis(SensorSnapshot::AXIS3);
+            double stick1 = input.axis(SensorSnapshot::AXIS1);
             
-            bool buttonL2;
-            bool buttonL1;
-
-            bool buttonX;
-            bool buttonB;
-            bool buttonA;
-
-            bool buttonUp = false;
-            bool buttonRight = false;
-            bool buttonDown = false;
-
-            // continuously check for inputs and translate to robot movement
-            while(true) {
-                /*
-                * UPDATE CONTROLLER VALUES
-                */
-                stick3 = Controller.Axis3.position(percentUnit);
-                stick1 = Controller.Axis1.position(percentUnit);
-                
-                buttonR2 = Controller.ButtonR2.pressing();
-                buttonR1 = Controller.ButtonR1.pressing();
-
-                buttonL2 = Controller.ButtonL2.pressing();
-                buttonL1 = Controller.ButtonL1.pressing();
-                
-                buttonX = Controller.ButtonX.pressing();
-                buttonB = Controller.ButtonB.pressing();
-                buttonA = Controller.ButtonA.pressing();
-                
-                buttonUp = Controller.ButtonUp.pressing();
-                buttonRight = Controller.ButtonRight.pressing();
-                buttonDown = Controller.ButtonDown.pressing();
-                
-                // TEMP
-                runPrint(baseTopLeftMotor.rotation(degreesUnit));
+            /*
+            * TRANSLATE STICK 3 for FORWARD / BACKWARDS and STICK 4 for ROTATE Motion
+            */
+            // move base only when sticks are not in neutral (when they become outside of movement threshold range)
+            if ( (stick3 > movementThreshold || stick3 < -movementThreshold) || (stick1 > movementThreshold || stick1 < -movementThreshold)) {
                 
-                /*
-                * TRANSLATE STICK 3 for FORWARD / BACKWARDS and STICK 4 for ROTATE Motion
-                */
-                // move base only when sticks are not in neutral (when they become outside of movement threshold range)
-                if ( (stick3 > movementThreshold || stick3 < -movementThreshold) || (stick1 > movementThreshold || stick1 < -movementThreshold)) {
-                    
-                    // calculate the cubed value of the linear stick, dampening sensitivity near the center and increasing sensitivity at the extremes
-                    stick3 = stick3 * fabs(stick3) / 100;
-                    
-                    baseMove(stick3 * 0.6, stick1 * 0.6);
-                } 
-
-                // Do not allow Controlled Towering Movement if the sticks are being used for normal movement
-
-                    /*
-                    * TRANSLATE BUTTONS X / B for SLOW FORWARD / SLOW BACKWARDS movement
-                    */
-                    else if (buttonX) {
-                        baseMove(10, 0);
-                    }
-                    else if (buttonB) {
-                        baseMove(-10, 0);
-                        intakeSpin(false, 0.2);
-                    }
-                    else { // if neither are pressed, stop movement
-                        baseMove(0,0);
-                    }
+                // calculate the cubed value of the linear stick, dampening sensitivity near the center and increasing sensitivity at the extremes
+                stick3 = stick3 * fabs(stick3) / 100;
                 
-                // Do not allow intake controls if either X and B are being used
+                baseMove(stick3 * 0.6, stick1 * 0.6);
+            } 
+
+            // Do not allow Controlled Towering Movement if the sticks are being used for normal movement
+
                 /*
-                * TRANSLATE BUTTONS R1 / R2 for INTAKE SPIN IN / INTAKE SPIN OUT motion
+                * TRANSLATE BUTTONS X / B for SLOW FORWARD / SLOW BACKWARDS movement
                 */
-                if (!buttonX && !buttonB) {
-                    if (buttonR2) {
-                        intakeSpin(true, 1); // in spin fast
-                    }
-                    else if (buttonR1) {
-                        intakeSpin(false, 0.2); // out spin slow
-                    }
-                    else if (buttonA) {
-                        intakeSpin(false,1); // out spin fast
-                    }
-                    else {
-                        intakeSpin(true,0); // stop
-                    }
+                else if (input.held(SensorSnapshot::BUTTON_X)) {
+                    baseMove(10, 0);
                 }
-                
-                
-                /*
-                * TRANSLATE BUTTONS UP / RIGHT / DOWN for ARM UP / ARM DOWN incremental motion
-                */
-                if (buttonUp) {
-                    armPivotToPercent(armPivotIncrementalPercents[2], 1);
+                else if (input.held(SensorSnapshot::BUTTON_B)) {
+                    baseMove(-10, 0);
+                    intakeSpin(false, 0.2);
+                }
+                else { // if neither are pressed, stop movement
+                    baseMove(0,0);
+                }
+            latency.commanded(LATENCY_BASE);
+        };
+        static void baseInputHandler(void *robot, const ControllerInput &input) {
+            static_cast<Robot *>(robot)->handleBaseInput(input);
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: handleIntakeInput
+        * Desc: intake handler of the driver loop, called when R1, R2, A, X or B changed
+        * Param: controller input
+        * Output: starts and stops intake
+        */
+        void handleIntakeInput(const ControllerInput &input) {
+            // Do not allow intake controls if either X and B are being used
+            /*
+            * TRANSLATE BUTTONS R1 / R2 for INTAKE SPIN IN / INTAKE SPIN OUT motion
+            */
+            if (!input.held(SensorSnapshot::BUTTON_X) && !input.held(SensorSnapshot::BUTTON_B)) {
+                if (input.held(SensorSnapshot::BUTTON_R2)) {
+                    intakeSpin(true, 1); // in spin fast
                 }
-                else if (buttonRight) {
-                    armPivotToPercent(armPivotIncrementalPercents[1], 1);
+                else if (input.held(SensorSnapshot::BUTTON_R1)) {
+                    intakeSpin(false, 0.2); // out spin slow
                 }
-                else if (buttonDown) {
-                    armPivot(false, 1);
+                else if (input.held(SensorSnapshot::BUTTON_A)) {
+                    intakeSpin(false,1); // out spin fast
                 }
                 else {
-                  armPivot(true,0);
+                    intakeSpin(true,0); // stop
                 }
-                
-                
+            }
+            latency.commanded(LATENCY_INTAKE);
+        };
+        static void intakeInputHandler(void *robot, const ControllerInput &input) {
+            static_cast<Robot *>(robot)->handleIntakeInput(input);
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: handleArmInput
+        * Desc: arm handler of the driver loop, called when Up, Right or Down changed and on every tick while one of them is held, since the
+        *       arm PID and the arm limits need the arm angle of every tick
+        * Param: controller input
+        * Output: pivots robot arm up and down
+        */
+        void handleArmInput(const ControllerInput &input) {
+            /*
+            * TRANSLATE BUTTONS UP / RIGHT / DOWN for ARM UP / ARM DOWN incremental motion
+            */
+            if (input.held(SensorSnapshot::BUTTON_UP)) {
+                armPivotToPercent(armPivotIncrementalPercents[2], 1);
+            }
+            else if (input.held(SensorSnapshot::BUTTON_RIGHT)) {
+                armPivotToPercent(armPivotIncrementalPercents[1], 1);
+            }
+            else if (input.held(SensorSnapshot::BUTTON_DOWN)) {
+                armPivot(false, 1);
+            }
+            else {
+              armPivot(true,0);
+            }
+            latency.commanded(LATENCY_ARM);
+        };
+        static void armInputHandler(void *robot, const ControllerInput &input) {
+            static_cast<Robot *>(robot)->handleArmInput(input);
+        };
+        
+        /* ------------------------------------------------------------------------
+        * Function: handleRampInput
+        * Desc: ramp handler of the driver loop, called when L1 or L2 changed and on every tick while one of them is held, for the ramp limits
+        * Param: controller input
+        * Output: activates or deactivates ramp lift
+        */
+        void handleRampInput(const ControllerInput &input) {
+            /*
+            * TRANSLATE BUTTON L1 / L2 for RAMP LIFT FORWARD / BACK motion
+            */
+            if (input.held(SensorSnapshot::BUTTON_L1)) {
+                rampLift(false, 0.5);
+            }
+            else if(input.held(SensorSnapshot::BUTTON_L2)) {
+                rampLift(true, 1);
+            }
+            else { // released: stop and hold once, the ramp keeps holding without being commanded again
+                rampLift(true, 0);
+            }
+            latency.commanded(LATENCY_RAMP);
+        };
+        static void rampInputHandler(void *robot, const ControllerInput &input) {
+            static_cast<Robot *>(robot)->handleRampInput(input);
+        };
+        
+        /*
+        * Function: driverMain
+        * Desc: Sets up driver controls and checks continuously during driver period to translate to controller inputs
+        * Param: none
+        * Output: Allows driver to control robot
+        */
+        void driverMain( void ) {
+            becomeControlTask();
+            startTelemetry();
+            startTrace("trace-driver.json");
+            //runPrint("Started driverMain", 1);
+            
+            // continuously check for inputs and translate to robot movement, once per control tick
+            foregroundPrimitive = TelemetryRecorder::PRIMITIVE_DRIVER;
+            autonomousRunning = false;
+            stopMotions();
+            controlScheduler.setLoop(LOOP_DRIVER);
+            controlScheduler.start();
+            readSensors();
+            // the first pass commands every subsystem
+            controllerInput.invalidate();
+            if (measureLatency) {
+                latencyReported = sensors.timestampMicros;
+                latency.start();
+            }
+            while(true) {
                 /*
-                * TRANSLATE BUTTON L1 / L2 for RAMP LIFT FORWARD / BACK motion
+                * UPDATE CONTROLLER VALUES from this tick's sensor snapshot, and hand the ones that changed to the subsystem handlers
                 */
-                if (buttonL1) {
-                    rampLift(false, 0.5);
-                }
-                else if(buttonL2) {
-                    rampLift(true, 1);
+                controllerInput.update(sensors);
+                if (measureLatency) {
+                    markInputChanges();
                 }
-                else {
-                    if(fabs(rampLiftMotor.velocity(percentVelocityUnit)) >= 2) {
-                        rampLift(true, 0);
-                    }
+                
+                controllerInput.dispatch();
+                
+                if (measureLatency) {
+                    reportLatency();
                 }
+                controlScheduler.waitForNextTick();
             }
         }
 };
@@ -1397,6 +2754,9 @@ int main() {
     Competition.autonomous(competitionAutonomous);
     Competition.drivercontrol(competitionDriver);
     
+    // the screen shows the log and the statistics page from the start, also while the robot waits for a competition period
+    robot->startTasks();
+    
     //competitionAutonomous();
     //competitionDriver();
         